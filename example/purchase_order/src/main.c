@@ -20,9 +20,9 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <assert.h>
 
 #include "PurchaseOrder.h"
+#include "parse_xml_file.h"
 
 /*
  *  ------------------------------ GLOBAL VARIABLES ------------------------------
@@ -59,35 +59,23 @@ int main(int argc, char *argv[])
     return 1;
   }
 
-  FILE* fXml = fopen(argv[1], "r");
-  if(fXml == NULL )
+  xml_file_t file;   // Holds the memory mapped XML file.
+  PurchaseOrder_t purchaseOrder;   // Holds the extracted content of XML file.
+
+  uint32_t shipTo_Quantity = 0;  // Variable that holds the occurrence of "ShipTo" element in the XML
+  xml_parse_result_t result = parse_xml_file(&PurchaseOrder_root, argv[1], &purchaseOrder, &file, &shipTo_Quantity);
+  if(result == XML_FILE_ERROR)
   {
     printf("Error in opening XML file\n");
     return 2;
   }
-
-  // Get the size of XML file to allocate the memory
-  fseek(fXml, 0, SEEK_END);
-  long size = ftell(fXml);
-  assert(size > 0);
-  fseek(fXml, 0, SEEK_SET);
-
-// Allocate the memory to copy XML source from file.
-  char* const xml = malloc((size_t)size);
-  fread(xml, 1, (size_t)size, fXml);
-  fclose(fXml);
-
-  PurchaseOrder_t purchaseOrder;   // Holds the extracted content of XML file.
-
-  uint32_t shipTo_Quantity = 0;  // Variable that holds the occurrence of "ShipTo" element in the XML
-  xml_parse_result_t result = parse_xml(&PurchaseOrder_root, xml, &purchaseOrder, &shipTo_Quantity);
   printf("%s\n", Result_Text[result]);
   if(result == XML_PARSE_SUCCESS)
   {
     print_purchase_order(&purchaseOrder, shipTo_Quantity);
   }
 
-  free(xml);
+  xml_file_close(&file);
 
   return 0;
 }
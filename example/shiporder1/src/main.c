@@ -20,9 +20,9 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <assert.h>
 
 #include "shiporder.h"
+#include "parse_xml_file.h"
 
 /*
  *  ------------------------------ GLOBAL VARIABLES ------------------------------
@@ -59,35 +59,23 @@ int main(int argc, char *argv[])
     return 1;
   }
 
-  FILE* fXml = fopen(argv[1], "r");
-  if(fXml == NULL )
+  xml_file_t file;   // Holds the memory mapped XML file.
+  shiporder_t book;   // Holds the extracted content of XML file.
+
+  uint32_t itemQuantity = 0;  // Variable that holds the occurrence of "item" element in the XML
+  xml_parse_result_t result = parse_xml_file(&shiporder_root, argv[1], &book, &file, &itemQuantity);
+  if(result == XML_FILE_ERROR)
   {
     printf("Error in opening XML file\n");
     return 2;
   }
-
-  // Get the size of XML file to allocate the memory
-  fseek(fXml, 0, SEEK_END);
-  long size = ftell(fXml);
-  assert(size > 0);
-  fseek(fXml, 0, SEEK_SET);
-
-// Allocate the memory to copy XML source from file.
-  char* const xml = malloc((size_t)size);
-  fread(xml, 1, (size_t)size, fXml);
-  fclose(fXml);
-
-  shiporder_t book;   // Holds the extracted content of XML file.
-
-  uint32_t itemQuantity = 0;  // Variable that holds the occurrence of "item" element in the XML
-  xml_parse_result_t result = parse_xml(&shiporder_root, xml, &book, &itemQuantity);
   printf("%s\n", Result_Text[result]);
   if(result == XML_PARSE_SUCCESS)
   {
     print_shiporder(&book, itemQuantity);
   }
 
-  free(xml);
+  xml_file_close(&file);
 
   return 0;
 }
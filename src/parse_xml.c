@@ -23,6 +23,7 @@
 
 #include "parse_xml.h"
 #include "parse_xml_internal.h"
+#include "xml_scan.h"
 
 /*
  *  ------------------------------- DEFINITION -------------------------------
@@ -36,485 +37,2597 @@ do {                                      \
 }while(0)
 
 //! Skips the white space till it finds the token
-#define ASSERT_TOKEN(source, token)                 \
+#define ASSERT_TOKEN(source, end, token)            \
 do {                                                \
-  source = skip_whitespace(source);                 \
+  source = skip_whitespace(source, end);            \
   ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");  \
   ASSERT((*source++ == token), XML_SYNTAX_ERROR, "XML is not well formed.\n");     \
 }while(0)
 
+//! Number of words of occurrence pool that track the attributes of an element:
+//! count of non optional attributes occurred, followed by the bit mask of occurred attributes.
+#define ATTRIBUTE_WORDS(quantity)  ((quantity) ? (((quantity) + 31) / 32 + 1) : 0)
+
 #if XML_PARSER_CONTEXT
   #define CONTEXT_PTR , void* context
   #define CONTEXT_ARG , context
+  #define PARSER_CONTEXT_ARG , parser->Context
 #else
   #define CONTEXT_PTR
   #define CONTEXT_ARG
+  #define PARSER_CONTEXT_ARG
 #endif // XML_PARSER_CONTEXT
 
 /*
- *	--------------------------- FORWARD DECLARATION ---------------------------
+ *  ------------------------------ FUNCTION BODY ------------------------------
  */
 
-static inline xml_parse_result_t parse_parent_element(const xs_element_t* const parent,
-                                                      const char** input,
-                                                      void* parent_target
-                                                      CONTEXT_PTR
-                                                      );
-/*
- *  ------------------------------ FUNCTION BODY ------------------------------
+#if XML_SCAN_DISPATCH
+/** \brief Selects the kernels on the first whitespace scan and skips the whitespace with it.
+ *  Arguments and return value are same as \ref skip_whitespace_scalar.
+ */
+static const char* resolve_skip_whitespace(const char* source, const char* const end)
+{
+  xml_parser_init_cpu();
+  return scan_get_kernel()->Skip_Whitespace(source, end);
+}
+
+/** \brief Selects the kernels on the first class scan and scans the class with it.
+ *  Arguments and return value are same as \ref scan_class_scalar.
+ */
+static const char* resolve_scan_class(const char* source, const char* const end,
+                                      const scan_class_t* const set)
+{
+  xml_parser_init_cpu();
+  return scan_get_kernel()->Scan_Class(source, end, set);
+}
+
+/** \brief Selects the kernels on the first text scan and scans the text with it.
+ *  Arguments and return value are same as \ref scan_text_scalar.
+ */
+static const char* resolve_scan_text(const char* source, const char* const end,
+                                     char delimiter, uint32_t* const property)
+{
+  xml_parser_init_cpu();
+  return scan_get_kernel()->Scan_Text(source, end, delimiter, property);
+}
+
+/** \brief Selects the kernels on the first indexing and indexes the class with it.
+ *  Arguments and return value are same as \ref index_class_with.
  */
+static size_t resolve_index_class(const char* source, const char* const end,
+                                  const scan_class_t* const set,
+                                  uint32_t* const position, size_t capacity)
+{
+  xml_parser_init_cpu();
+  return scan_get_kernel()->Index_Class(source, end, set, position, capacity);
+}
+
+//! Kernels resolving the kernels in use on their first call, unless selected by xml_parser_init_cpu.
+static const scan_kernel_t SCAN_RESOLVE_KERNEL =
+{
+  "", resolve_skip_whitespace, resolve_scan_class, resolve_scan_text, resolve_index_class
+};
+
+//! Concurrent first calls select the same kernels and store the pointer to them atomically.
+static const scan_kernel_t* xml_scan_kernel = &SCAN_RESOLVE_KERNEL;
+#endif // XML_SCAN_DISPATCH
 
 /** \brief This function skips/ignore all the whitespace chars
- *         till it reaches to non-whitespace char or end of string.
+ *         till it reaches to non-whitespace char or end of source.
  *
  * \param source const char* Source : string to skip whitespace
+ * \param end const char* const : End of source
  * \return const char*  Address of first non-whitespace char in the string or
- *                      NULL on end of string
+ *                      NULL on end of source
+ */
+static inline const char* skip_whitespace(const char* source, const char* const end)
+{
+  return scan_whitespace(source, end);
+}
+
+#if XML_PARSER_INDEX
+/** \brief Returns the next indexed structural char of source.
+ *  Parser never moves backward, so positions before the source are never looked at again.
+ *
+ * \param index xml_index_t* const : Structural index of XML source.
+ * \param source const char* : Current position of parser
+ * \param end const char* const : End of source
+ * \return const char* : Address of first structural char at or after source or NULL on end of source.
  */
-static inline const char* skip_whitespace(const char* source)
+static inline const char* get_indexed_char(xml_index_t* const index, const char* source, const char* const end)
 {
-  do
+  const size_t offset = source - index->Source;
+  size_t next = index->Next;
+  while((next < index->Count) && (index->Position[next] < offset))
   {
-    switch(*source)
-    {
-    case '\0':
-      return NULL;
+    next++;
+  }
+  index->Next = next;
 
-    case '\r':
-    case '\n':
-    case '\t':
-    case ' ':
-      source++;
-      break;
+  if((next < index->Count) && (index->Position[next] < (size_t)(end - index->Source)))
+  {
+    return &index->Source[index->Position[next]];
+  }
+  return NULL;
+}
+#endif // XML_PARSER_INDEX
 
-    default:
-      return source;
+/** \brief Finds the end of element or attribute name.
+ *  With structural index the scan is bounded by the next structural char ('>', '/' or '='),
+ *  so that only the whitespace before it is looked for.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param source const char* : Start of name
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : End of name (ELEMENT_NAME_END or ATTRIBUTE_NAME_END)
+ * \return const char* : Address of end of name or NULL on end of source.
+ */
+static inline const char* get_name_end(const xml_parser_t* const parser, const char* source,
+                                       const char* const end, const scan_class_t* const set)
+{
+#if XML_PARSER_INDEX
+  if(parser->Index != NULL)
+  {
+    const char* const structural = get_indexed_char(parser->Index, source, end);
+    if(structural != NULL)
+    {
+      source = scan_class(source, structural, set);
+      return (source != NULL) ? source : structural;
     }
-  }while(1);
+  }
+#else
+  (void)parser;
+#endif // XML_PARSER_INDEX
+  return scan_class(source, end, set);
 }
 
 /** \brief gets the elements end tag ('>' or '/>').
  *
+ * \param parser const xml_parser_t* const : XML parser.
  * \param source const char* : Source XML string to find element end tag
- * \return const char* : returns the address of end tag or NULL on end of string.
+ * \param end const char* const : End of source
+ * \return const char* : returns the address of end tag or NULL on end of source.
  */
-static inline const char* get_element_end_tag(const char* source)
+static inline const char* get_element_end_tag(const xml_parser_t* const parser,
+                                              const char* source, const char* const end)
 {
-  while(1)
+  return get_name_end(parser, source, end, &ELEMENT_NAME_END);
+}
+
+/** \brief returns the end of attribute tag.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param source const char* : Source of XMl string to find end of attribute tag
+ * \param end const char* const : End of source
+ * \return const char* : returns end of attribute tag or NULL on end of source.
+ */
+static inline const char* get_attribute_tag(const xml_parser_t* const parser,
+                                            const char* source, const char* const end)
+{
+  return get_name_end(parser, source, end, &ATTRIBUTE_NAME_END);
+}
+
+/** \brief Compares the start of source with the token.
+ *
+ * \param source const char* : Source XML string
+ * \param end const char* const : End of source
+ * \param token const char* const : token string to compare
+ * \param length size_t : length of token string
+ * \return bool : true if source starts with token. false if it doesn't or source is shorter than token.
+ */
+static inline bool match_token(const char* source, const char* const end,
+                               const char* const token, size_t length)
+{
+  return ((size_t)(end - source) >= length) && (memcmp(source, token, length) == 0);
+}
+
+/** \brief Finds the terminator ("?>", "-->" or "]]>") of markup.
+ *  It scans for the first char of terminator with memchr and then verifies the chars after it.
+ *  Properties of the skipped text are not collected.
+ *
+ * \param source const char* : Source XML string after the start of markup
+ * \param end const char* const : End of source
+ * \param token const char* const : terminator
+ * \param length size_t : length of terminator
+ * \return const char* : returns address of terminator or NULL on end of source.
+ */
+static inline const char* get_terminator(const char* source, const char* const end,
+                                         const char* const token, size_t length)
+{
+  while((source = memchr(source, token[0], end - source)) != NULL)
   {
-    switch(*source)
+    if((size_t)(end - source) < length)
     {
-    case '\0':
       return NULL;
-
-    case '\r':
-    case '\n':
-    case '\t':
-    case ' ':
-
-    case '>':
-    case '/':
+    }
+    if(memcmp(source + 1, token + 1, length - 1) == 0)
+    {
       return source;
+    }
+    source++;
+  }
+  return NULL;
+}
 
-    default:
-      source++;
-      break;
+/** \brief Finds the terminator of markup, collecting the properties of the text before it.
+ *  It scans for the last char of terminator with the text kernel and then verifies the chars before it.
+ *
+ * \param source const char* : Source XML string after the start of markup
+ * \param end const char* const : End of source
+ * \param token const char* const : terminator
+ * \param length size_t : length of terminator
+ * \param property uint32_t* const : Properties (xml_text_property_t) of the text before the terminator.
+ * \return const char* : returns address of terminator or NULL on end of source.
+ */
+static inline const char* get_text_terminator(const char* source, const char* const end,
+                                              const char* const token, size_t length,
+                                              uint32_t* const property)
+{
+  const char* const start = source;
+  while((source = scan_text(source, end, token[length - 1], property)) != NULL)
+  {
+    if(((size_t)(source - start) >= length - 1) &&
+       (memcmp(source - (length - 1), token, length - 1) == 0))
+    {
+      return source - (length - 1);
     }
+    source++;
   }
+  return NULL;
 }
 
-/** \brief returns the end of attribute tag.
+/** \brief Finds the end of DOCTYPE declaration, skipping its internal subset.
+ *  Brackets, quoted literals and comments of internal subset are matched, so that '>' inside them doesn't end the declaration.
+ *  Scan state is held in depth and delimiter, so that a declaration split across chunks is scanned incrementally.
  *
- * \param source const char* : Source of XMl string to find end of attribute tag
- * \return const char* : returns end of attribute tag or NULL on end of string.
+ * \param input const char** : Source XML string after "<!DOCTYPE". On end of source, it is set to the position
+ *        to resume the scan from on the next chunk.
+ * \param end const char* const : End of source
+ * \param depth uint32_t* : Nesting depth of brackets
+ * \param delimiter uint32_t* : Delimiter of open quoted literal ('"' or '\'') or comment ('-'). 0 if none.
+ * \return const char* : returns address after the end of declaration or NULL on end of source.
  */
-static inline const char* get_attribute_tag(const char* source)
+static inline const char* get_doctype_end(const char** input, const char* const end,
+                                          uint32_t* depth, uint32_t* delimiter)
 {
-  while(1)
+  const char* source = *input;
+  while(true)
   {
-    switch(*source)
+    if(*delimiter == '-')
+    {
+      const char* const comment = get_terminator(source, end, "-->", sizeof("-->") - 1);
+      if(comment == NULL)
+      {
+        // Keep the chars that may start the terminator.
+        *input = (end - source > (ptrdiff_t)(sizeof("-->") - 2)) ? end - (sizeof("-->") - 2) : source;
+        return NULL;
+      }
+      source = comment + (sizeof("-->") - 1);
+      *delimiter = 0;
+    }
+    else if(*delimiter != 0)
+    {
+      source = memchr(source, (int)*delimiter, end - source);
+      if(source == NULL)
+      {
+        *input = end;
+        return NULL;
+      }
+      source++;
+      *delimiter = 0;
+    }
+
+    source = scan_class(source, end, &DOCTYPE_CHAR);
+    if(source == NULL)
     {
-    case '\0':
+      *input = end;
       return NULL;
+    }
 
-    case '\r':
-    case '\n':
-    case '\t':
-    case ' ':
+    switch(*source)
+    {
+    case '"':
+    case '\'':
+      *delimiter = (uint8_t)*source;
+      break;
 
-    case '=':
-      return source;
+    case '<':
+      if(match_token(source, end, "<!--", sizeof("<!--") - 1))
+      {
+        *delimiter = '-';
+        source += (sizeof("<!--") - 1) - 1;
+      }
+      else if((end - source < (ptrdiff_t)(sizeof("<!--") - 1)) && (memcmp(source, "<!--", end - source) == 0))
+      {
+        *input = source;    // Wait for the rest of the source if it could be start of comment.
+        return NULL;
+      }
+      break;
 
-    default:
-      source++;
+    case '[':
+      (*depth)++;
+      break;
+
+    case ']':
+      if(*depth > 0)
+      {
+        (*depth)--;
+      }
+      break;
+
+    default:    // '>'
+      if(*depth == 0)
+      {
+        return source + 1;
+      }
       break;
     }
+    source++;
   }
 }
 
-/** \brief Get the target address to store XML content based on address type.
+/** \brief Finds the end of markup starting with "<!": comment, CDATA section or DOCTYPE declaration.
  *
- * \param address const target_address_t*const : target address type.
- * \param target void* : parent element target address. Used only in relative type of target address
- * \param occurrence uint32_t : occurrence of element in the XMl.
- * \param context void* : user defined context. used only in dynamic type of target address.
- * \return void* : Returns the target address to store XML content.
+ * \param source const char* : Source XML string at "<!"
+ * \param end const char* const : End of source
+ * \return const char* : returns address after the end of markup or NULL on end of source.
  */
-static inline void* get_target_address(const target_address_t* const address,
-                                       void* target, uint32_t occurrence
-                                       CONTEXT_PTR)
+static inline const char* get_declaration_end(const char* source, const char* const end)
 {
-  switch(address->Type)
+  if(match_token(source, end, "<!--", sizeof("<!--") - 1))
+  {
+    source = get_terminator(source + (sizeof("<!--") - 1), end, "-->", sizeof("-->") - 1);
+    return (source != NULL) ? source + (sizeof("-->") - 1) : NULL;
+  }
+  if(match_token(source, end, "<![CDATA[", sizeof("<![CDATA[") - 1))
+  {
+    source = get_terminator(source + (sizeof("<![CDATA[") - 1), end, "]]>", sizeof("]]>") - 1);
+    return (source != NULL) ? source + (sizeof("]]>") - 1) : NULL;
+  }
+  if(match_token(source, end, "<!DOCTYPE", sizeof("<!DOCTYPE") - 1))
+  {
+    uint32_t depth = 0;
+    uint32_t delimiter = 0;
+    source += sizeof("<!DOCTYPE") - 1;
+    return get_doctype_end(&source, end, &depth, &delimiter);
+  }
+  // Markup is either incomplete or not known. Skip the unknown markup till '>'.
+  if(end - source < (ptrdiff_t)(sizeof("<![CDATA[") - 1))
   {
-  case EN_STATIC:
-    return (void*)((size_t)(address->Address) + (occurrence * address->Size));
-
-  case EN_DYNAMIC:
-    return address->Allocate(occurrence CONTEXT_ARG);
-
-  case EN_RELATIVE:
-    return (void*)((size_t)(target) + (occurrence * address->Size) + address->Offset);
-
-  default:
     return NULL;
   }
+  source = memchr(source, '>', end - source);
+  return (source != NULL) ? source + 1 : NULL;
 }
 
-/** \brief Verify that all the required attributes occurred in the XML element.
+/** \brief Finds the end of processing instruction or XML declaration.
  *
- * \param element const xs_element_t* const : XML element to verify
- * \param occurrence const bool*const : Occurrence table of attribute
- * \return xml_parse_result_t result of validation.
+ * \param source const char* : Source XML string at "<?"
+ * \param end const char* const : End of source
+ * \return const char* : returns address after "?>" or NULL on end of source.
  */
-static inline xml_parse_result_t validate_attributes(const xs_element_t* const element,
-                                                     const bool* const occurrence)
+static inline const char* get_instruction_end(const char* source, const char* const end)
 {
-  for(uint32_t i = 0; i < element->Attribute_Quantity; i++)
-  {
-    ASSERT((occurrence[i] || element->Attribute[i].Use == EN_OPTIONAL),
-           XML_ATTRIBUTE_NOT_FOUND,
-           "required attribute '%s' not found\n", element->Attribute[i].Name.String);
-  }
-  return XML_PARSE_SUCCESS;
+  source = get_terminator(source + (sizeof("<?") - 1), end, "?>", sizeof("?>") - 1);
+  return (source != NULL) ? source + (sizeof("?>") - 1) : NULL;
 }
 
-/** \brief Validate an empty element.
+/** \brief Checks if the source starts with XML declaration ("<?xml" followed by whitespace),
+ *  unlike a processing instruction e.g. "<?xml-stylesheet".
  *
- * \param element const xs_element_t*const : element to validate.
- * \return xml_parse_result_t result of validation.
+ * \param source const char* : Source XML string
+ * \param end const char* const : End of source
+ * \return bool : true if source starts with XML declaration.
  */
-static inline xml_parse_result_t validate_empty_element(const xs_element_t* const element)
+static inline bool is_xml_declaration(const char* source, const char* const end)
 {
-  for(uint32_t i = 0; i < element->Child_Quantity; i++)
+  if(!match_token(source, end, "<?xml", sizeof("<?xml") - 1) || (end - source == sizeof("<?xml") - 1))
   {
-    ASSERT((!element->Child[i].MinOccur), XML_ELEMENT_MIN_OCCURRENCE_ERR,
-           "XML element '%s' occurred less than specified count %d in the schema\n",
-           element->Child[i].Name.String, element->Child[i].MinOccur);
+    return false;
   }
 
-  ASSERT((element->Content.Type == EN_NO_XML_DATA_TYPE), XML_CONTENT_ERROR,
-         "XML element '%s' does not contains content as specified in the schema.\n", element->Name.String);
+  switch(source[sizeof("<?xml") - 1])
+  {
+  case ' ':
+  case '\t':
+  case '\r':
+  case '\n':
+    return true;
 
-  return XML_PARSE_SUCCESS;
+  default:
+    return false;
+  }
 }
 
-/** \brief Validate that in case of child element order is specified as choice then
- * only one child element can be present.(Though it can have multiple
- * occurrence of that element as specified in the maxOccur)
+/** \brief Skips the misc (whitespace, comments and processing instructions other than XML declaration)
+ *  that may follow a document.
  *
- * \param occurrence uint32_t* : pointer to array of occurrence table
- * \param quantity size_t : Number of child elements
- * \return bool : return true if only on child element occurred otherwise false.
+ * \param source const char* : Source XML string
+ * \param end const char* const : End of source
+ * \return const char* : Start of the next markup that is not misc, or incomplete comment or processing instruction.
+ *                       NULL if only misc is left in the source.
  */
-static inline bool validate_choice_order(uint32_t* occurrence, size_t quantity)
+static const char* skip_misc(const char* source, const char* const end)
 {
-  uint32_t count = 0;
-  for(uint32_t i = 0; i < quantity; i++)
+  while((source = skip_whitespace(source, end)) != NULL)
   {
-    if(occurrence[i])
+    const char* markup;
+    if(match_token(source, end, "<!--", sizeof("<!--") - 1))
     {
-      if(++count > 1)
-      {
-        return false;   // More than one child elements found
-      }
+      markup = get_declaration_end(source, end);
     }
+    else if(match_token(source, end, "<?", sizeof("<?") - 1) && !is_xml_declaration(source, end))
+    {
+      markup = get_instruction_end(source, end);
+    }
+    else
+    {
+      return source;
+    }
+
+    if(markup == NULL)
+    {
+      return source;
+    }
+    source = markup;
   }
-  return true;
+  return NULL;
 }
 
-/** \brief validate the XML element. Check for matching end element tag.
+/** \brief Finds the end of text (content or attribute value).
+ *  Parser jumps to the indexed position of delimiter if source has structural index,
+ *  else it scans the text collecting its properties.
  *
- * \param element const xs_element_t*const : element to validate.
- * \param input const char** : Input XML string.
- * \return xml_parse_result_t : result of element validation
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param source const char* : Start of text
+ * \param end const char* const : End of source
+ * \param delimiter char : End of text ('<' for content, '"' for attribute value)
+ * \param property uint32_t* const : Properties (xml_text_property_t) of text. With structural index
+ *        they are collected only for the reader event, the only user of them.
+ * \return const char* : Address of delimiter or NULL on end of source.
  */
-static inline xml_parse_result_t validate_element(const xs_element_t* const element,
-                                                  const char** input)
+static inline const char* get_text_end(const xml_parser_t* const parser, const char* source,
+                                       const char* const end, char delimiter, uint32_t* const property)
 {
-  const char* const tag = *input;
-  const char* source = get_element_end_tag(*input);
-  ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end tag of element.\n");
-  size_t length = source - tag;
+#if XML_PARSER_INDEX
+  if(parser->Index != NULL)
+  {
+    const char* const text = source;
+    while(((source = get_indexed_char(parser->Index, source, end)) != NULL) && (*source != delimiter))
+    {
+      source++;
+    }
+    // Delimiter is a structural char, so the text has no delimiter to stop the scan before its end.
+    if((source != NULL) && (parser->Event != NULL))
+    {
+      scan_text(text, source, delimiter, property);
+    }
+    return source;
+  }
+#else
+  (void)parser;
+#endif // XML_PARSER_INDEX
+  return scan_text(source, end, delimiter, property);
+}
 
-  ASSERT((length == element->Name.Length) && (strncmp(element->Name.String, tag, length) == 0),
-         XML_END_TAG_NOT_FOUND,
-         "End tag '%.*s' does not match with start tag '%s' of an element.\n", (int)length, tag, element->Name.String);
+#if XML_PARSER_LOOKUP
+//! Marks the free slot of lookup table while building it.
+#define LOOKUP_FREE_SLOT  UINT16_MAX
 
-  ASSERT_TOKEN(source, '>');
-  *input = source;
-  return XML_PARSE_SUCCESS;
-}
+//! Returns the hash of an entry of list to build the lookup of list.
+typedef uint64_t (*lookup_hash_t)(const void* list, uint32_t index);
 
-/** \brief Parses XML attribute and extracts the content of attribute
+/** \brief Returns the hash of name of child element.
  *
- * \param attribute const xs_attribute_t*const : Structure defining XML attribute to parse.
- * \param input const char** : input XML string to parse and extract the content of attribute
- * \param target void* : Target address to store XMl content
- * \param context void* : User defined context.
- * \return xml_parse_result_t result of parsing
+ * \param list const void* : Array of child elements (xs_element_t)
+ * \param index uint32_t : index of child element
+ * \return uint64_t : hash of name
  */
-static inline xml_parse_result_t parse_attribute(const xs_attribute_t* const attribute,
-                                                 const char** input, void* target
-                                                 CONTEXT_PTR)
+static uint64_t get_child_hash(const void* list, uint32_t index)
 {
-  const char* source = *input;
-
-  ASSERT_TOKEN(source, '=');
-  ASSERT_TOKEN(source, '"');
+  const string_t* const name = &((const xs_element_t*)list)[index].Name;
+  return get_name_hash(name->String, name->Length);
+}
 
-  const char* const tag = source;
-  source = strchr(source, '"');
-  ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");
-  size_t length = source++ - tag;
-  *input = source;
-  return extract_content(&attribute->Content,
-                   get_target_address(&attribute->Target, target, 0 CONTEXT_ARG),
-                   tag, length);
+/** \brief Returns the hash of name of attribute.
+ *
+ * \param list const void* : Array of attributes (xs_attribute_t)
+ * \param index uint32_t : index of attribute
+ * \return uint64_t : hash of name
+ */
+static uint64_t get_attribute_hash(const void* list, uint32_t index)
+{
+  const string_t* const name = &((const xs_attribute_t*)list)[index].Name;
+  return get_name_hash(name->String, name->Length);
 }
 
-/** \brief parses a XML string to extract attribute and its content as specified
- *         in the given xs_element_t
+/** \brief Returns the hash of string enumeration.
  *
- * \param element const xs_element_t*const : Contain schema definition of an element.
- * \param input const char** : Input XML string to parse
- * \param target void* : Target address to store XML content.
- * \param context void* : User specified context.
- * \return xml_parse_result_t : result of parsing.
+ * \param list const void* : Array of string enumerations (string_t)
+ * \param index uint32_t : index of enumeration
+ * \return uint64_t : hash of enumeration
  */
-static inline xml_parse_result_t parse_element(const xs_element_t* const element,
-                                               const char** input, void* target
-                                               CONTEXT_PTR)
+static uint64_t get_enum_string_hash(const void* list, uint32_t index)
 {
-  bool occurrence[element->Attribute_Quantity];
-  uint32_t attribute_occurred = 0;
-  const char* source = *input;
+  const string_t* const name = &((const string_t*)list)[index];
+  return get_name_hash(name->String, name->Length);
+}
 
-  for(uint32_t i = 0; i < element->Attribute_Quantity; i++)
-  {
-    occurrence[i] = false;
-  }
+/** \brief Returns the hash of unsigned integer enumeration.
+ *
+ * \param list const void* : Array of unsigned integer enumerations (uint32_t)
+ * \param index uint32_t : index of enumeration
+ * \return uint64_t : hash of enumeration
+ */
+static uint64_t get_enum_uint_hash(const void* list, uint32_t index)
+{
+  return get_value_hash(((const uint32_t*)list)[index]);
+}
 
-  while(1)
+/** \brief Places all the entries of bucket in the free slots with the given displacement.
+ *
+ * \param lookup xs_lookup_t* const : Lookup to build
+ * \param list const void* : List of entries
+ * \param quantity uint32_t : Number of entries
+ * \param get_hash lookup_hash_t : Returns the hash of entry
+ * \param bucket uint32_t : Bucket to place
+ * \param displacement uint32_t : displacement of bucket
+ * \return bool : true if all the entries of bucket are placed in distinct free slots.
+ */
+static bool place_lookup_bucket(xs_lookup_t* const lookup, const void* list, uint32_t quantity,
+                                lookup_hash_t get_hash, uint32_t bucket, uint32_t displacement)
+{
+  const uint32_t buckets = (quantity + 1) / 2;
+  uint16_t* const slot = &lookup->Table[buckets];
+  for(uint32_t i = 0; i < quantity; i++)
   {
-    source = skip_whitespace(source);
-    ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");
-
-    switch(*source)
+    const uint64_t hash = get_hash(list, i);
+    if(get_lookup_bucket(hash, buckets) != bucket)
     {
-    case '/':
-      {
-        source++;
-        ASSERT((*source++ == '>'), XML_SYNTAX_ERROR, "XML is not well formed. Missing '>' after '/'.\n");
-        ASSERT_RESULT(validate_attributes(element, occurrence));
-        *input = source;
-        return validate_empty_element(element);
-      }
+      continue;
+    }
 
-    case '>':
+    const uint32_t index = get_lookup_slot(hash, displacement, quantity);
+    if(slot[index] != LOOKUP_FREE_SLOT)
+    {
+      // Undo the entries of bucket placed so far.
+      for(uint32_t j = 0; j < i; j++)
       {
-        ASSERT_RESULT(validate_attributes(element, occurrence));
-        source++;
-        if(element->Child_Quantity > 0)
-        {
-          *input = source;
-          ASSERT_RESULT(parse_parent_element(element, input, target CONTEXT_ARG));
-          source = *input;
-        }
-        else if(element->Content.Type != EN_NO_XML_DATA_TYPE)
+        const uint64_t placed_hash = get_hash(list, j);
+        const uint32_t placed_index = get_lookup_slot(placed_hash, displacement, quantity);
+        if((get_lookup_bucket(placed_hash, buckets) == bucket) && (slot[placed_index] == j))
         {
-          const char* const tag = source;
-          source = strchr(source, '<');
-          ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end tag of element '%s'\n",
-                 element->Name.String);
-          size_t length = source++ - tag;
-
-          ASSERT_RESULT(extract_content(&element->Content, target, tag, length));
-          ASSERT(*source++ == '/', XML_SYNTAX_ERROR, "XML is not well formed. Missing '/' after '<'.\n");
+          slot[placed_index] = LOOKUP_FREE_SLOT;
         }
-        else
-        {
-          ASSERT_TOKEN(source, '<');
-          ASSERT(*source++ == '/', XML_SYNTAX_ERROR, "XML is not well formed.Missing '/' after '<'.\n");
-        }
-        *input = source;
-        return validate_element(element, input);
       }
+      return false;
     }
+    slot[index] = (uint16_t)i;
+  }
+  return true;
+}
 
-    ASSERT(attribute_occurred != element->Attribute_Quantity, XML_SYNTAX_ERROR,
-           "XML is not well formed. Missing end tag of element '%s'.\n", element->Name.String);
-
-    const char* const tag = source;
-    source = get_attribute_tag(source);
-    ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing element '%s' attribute\n",
-           element->Name.String);
-    size_t length = source - tag;
-    uint32_t i = 0;
-    while(1)
+/** \brief Builds the minimal perfect hash (hash and displace) of a list of entries.
+ *  Buckets are placed from the largest to the smallest, trying displacements till all its entries find free slots.
+ *
+ * \param lookup xs_lookup_t* const : Lookup to build
+ * \param list const void* : List of entries
+ * \param quantity uint32_t : Number of entries
+ * \param get_hash lookup_hash_t : Returns the hash of entry
+ * \return bool : true on success. false if entries can't be hashed perfectly, lookup is left empty.
+ */
+static bool build_lookup(xs_lookup_t* const lookup, const void* list, uint32_t quantity, lookup_hash_t get_hash)
+{
+  const uint32_t buckets = (quantity + 1) / 2;
+  lookup->Quantity = 0;
+  if((quantity == 0) || (quantity >= LOOKUP_FREE_SLOT))
+  {
+    return false;
+  }
+
+  memset(lookup->Table, 0, buckets * sizeof(uint16_t));
+  memset(&lookup->Table[buckets], 0xFF, quantity * sizeof(uint16_t));
+
+  uint32_t size[buckets];
+  memset(size, 0, sizeof(size));
+  uint32_t largest = 0;
+  for(uint32_t i = 0; i < quantity; i++)
+  {
+    const uint32_t bucket = get_lookup_bucket(get_hash(list, i), buckets);
+    if(++size[bucket] > largest)
+    {
+      largest = size[bucket];
+    }
+  }
+
+  for(uint32_t count = largest; count > 0; count--)
+  {
+    for(uint32_t bucket = 0; bucket < buckets; bucket++)
+    {
+      if(size[bucket] != count)
+      {
+        continue;
+      }
+
+      uint32_t displacement = 0;
+      while(!place_lookup_bucket(lookup, list, quantity, get_hash, bucket, displacement))
+      {
+        if(++displacement == LOOKUP_FREE_SLOT)
+        {
+          return false;
+        }
+      }
+      lookup->Table[bucket] = (uint16_t)displacement;
+    }
+  }
+
+  lookup->Quantity = quantity;
+  return true;
+}
+
+/** \brief Builds the lookup of enumerations of content.
+ *
+ * \param content const xml_content_t* : content of element or attribute
+ */
+static void init_content_lookup(const xml_content_t* content)
+{
+  const enum_facet_t* const facet = &content->Facet.Enum;
+  if((facet->Lookup == NULL) || (facet->Lookup->Quantity == facet->Quantity))
+  {
+    return;
+  }
+
+  if(content->Type == EN_ENUM_STRING)
+  {
+    build_lookup(facet->Lookup, facet->List, facet->Quantity, get_enum_string_hash);
+  }
+  else if(content->Type == EN_ENUM_UINT)
+  {
+    build_lookup(facet->Lookup, facet->List, facet->Quantity, get_enum_uint_hash);
+  }
+}
+
+/** \brief Builds the lookup of an element and its descendants.
+ *
+ * \param element const xs_element_t* : element of XML element tree
+ * \param depth uint32_t : depth of element. Recursive schema is followed till the maximum depth of parser.
+ */
+static void init_element_lookup(const xs_element_t* element, uint32_t depth)
+{
+  if((element->Child_Lookup != NULL) && (element->Child_Lookup->Quantity != element->Child_Quantity))
+  {
+    build_lookup(element->Child_Lookup, element->Child, element->Child_Quantity, get_child_hash);
+  }
+
+  xs_lookup_t* const lookup = element->Attribute_Lookup;
+  if((lookup != NULL) && (lookup->Quantity != element->Attribute_Quantity) &&
+     build_lookup(lookup, element->Attribute, element->Attribute_Quantity, get_attribute_hash))
+  {
+    lookup->Required = 0;
+    for(uint32_t i = 0; i < element->Attribute_Quantity; i++)
+    {
+      lookup->Required += (element->Attribute[i].Use != EN_OPTIONAL);
+    }
+  }
+
+  init_content_lookup(&element->Content);
+  for(uint32_t i = 0; i < element->Attribute_Quantity; i++)
+  {
+    init_content_lookup(&element->Attribute[i].Content);
+  }
+
+  if(depth < XML_PARSER_MAX_DEPTH)
+  {
+    for(uint32_t i = 0; i < element->Child_Quantity; i++)
+    {
+      init_element_lookup(&element->Child[i], depth + 1);
+    }
+  }
+}
+#endif // XML_PARSER_LOOKUP
+
+#if XML_PARSER_COMPILE
+//! Alignment of arrays of compiled schema (size of cache line).
+#define COMPILED_ALIGNMENT  64
+
+//! Rounds up the size to the alignment of arrays of compiled schema.
+#define COMPILED_ALIGN(size)  (((size) + COMPILED_ALIGNMENT - 1) & ~(size_t)(COMPILED_ALIGNMENT - 1))
+
+//! Maximum number of attributes of compiled element matched linearly, without the lookup.
+//! Attributes usually occur in schema order, which the linear matching finds faster than the hash for few attributes.
+#define COMPILED_LINEAR_ATTRIBUTES  16
+
+//! Array of child elements of an element, compiled to consecutive nodes.
+typedef struct
+{
+  const xs_element_t* Element;  //!< Array of child elements
+  uint32_t Quantity;            //!< Number of child elements
+  uint32_t Node;                //!< Node of first child element
+}compiled_block_t;
+
+/** \brief Finds the compiled array of child elements.
+ *
+ * \param block const compiled_block_t* : compiled arrays of child elements
+ * \param count uint32_t : number of compiled arrays
+ * \param child const xs_element_t* : array of child elements to find
+ * \return const compiled_block_t* : compiled array. NULL if not found.
+ */
+static const compiled_block_t* find_compiled_block(const compiled_block_t* block, uint32_t count,
+                                                   const xs_element_t* child)
+{
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(block[i].Element == child)
+    {
+      return &block[i];
+    }
+  }
+  return NULL;
+}
+
+/** \brief Reserves an array in the compiled schema.
+ *
+ * \param size size_t* : size of compiled schema. Incremented by the aligned size of array.
+ * \param array size_t : size of array
+ * \return size_t : offset of array in the compiled schema.
+ */
+static size_t reserve_compiled_array(size_t* size, size_t array)
+{
+  const size_t offset = *size;
+  *size += COMPILED_ALIGN(array);
+  return offset;
+}
+
+/** \brief Returns the number of lookup table entries of a node of compiled schema.
+ *
+ * \param element const xs_element_t* : element of node
+ * \return size_t : number of entries of lookup of child elements and attributes.
+ */
+static size_t get_compiled_table_size(const xs_element_t* element)
+{
+  size_t size = 0;
+  if(element->Attribute_Quantity > COMPILED_LINEAR_ATTRIBUTES)
+  {
+    size += XS_LOOKUP_SIZE(element->Attribute_Quantity);
+  }
+  if(element->Child_Order != EN_SEQUENCE)
+  {
+    size += XS_LOOKUP_SIZE(element->Child_Quantity);
+  }
+  return size;
+}
+
+/** \brief Fills a node of compiled schema and builds its lookups.
+ *
+ * \param compiled xs_compiled_t* const : compiled schema
+ * \param node uint32_t : node to fill
+ * \param element const xs_element_t* : element of node
+ * \param child uint32_t : first child node of element
+ * \param table uint16_t* : storage of lookup tables of node
+ * \return uint16_t* : storage of lookup tables of next node.
+ */
+static uint16_t* compile_node(xs_compiled_t* const compiled, uint32_t node, const xs_element_t* element,
+                              uint32_t child, uint16_t* table)
+{
+  compiled->Element[node]        = element;
+  compiled->Name_Length[node]    = (uint32_t)element->Name.Length;
+  compiled->Name_Prefix[node]    = get_name_prefix(element->Name.String, element->Name.Length);
+  compiled->Name_Mask[node]      = 0;
+  memset(&compiled->Name_Mask[node], 0xFF, (element->Name.Length < 8) ? element->Name.Length : 8);
+  compiled->Name_Suffix[node]    = 0;
+  if(element->Name.Length > 8)
+  {
+    memcpy(&compiled->Name_Suffix[node], element->Name.String + element->Name.Length - 8, 8);
+  }
+  compiled->Child[node]          = child;
+  compiled->Child_Quantity[node] = element->Child_Quantity;
+  compiled->Min_Occur[node]      = element->MinOccur;
+  compiled->Max_Occur[node]      = element->MaxOccur;
+
+  xs_lookup_t* lookup = &compiled->Child_Lookup[node];
+  lookup->Table    = NULL;
+  lookup->Quantity = 0;
+  lookup->Required = 0;
+  if(element->Child_Order != EN_SEQUENCE)
+  {
+    lookup->Table = table;
+    table += XS_LOOKUP_SIZE(element->Child_Quantity);
+    build_lookup(lookup, element->Child, element->Child_Quantity, get_child_hash);
+  }
+
+  lookup = &compiled->Attribute_Lookup[node];
+  lookup->Table    = NULL;
+  lookup->Quantity = 0;
+  lookup->Required = 0;
+  if(element->Attribute_Quantity > COMPILED_LINEAR_ATTRIBUTES)
+  {
+    lookup->Table = table;
+    table += XS_LOOKUP_SIZE(element->Attribute_Quantity);
+    build_lookup(lookup, element->Attribute, element->Attribute_Quantity, get_attribute_hash);
+  }
+  for(uint32_t i = 0; i < element->Attribute_Quantity; i++)
+  {
+    lookup->Required += (element->Attribute[i].Use != EN_OPTIONAL);
+  }
+  return table;
+}
+#endif // XML_PARSER_COMPILE
+
+/** \brief Counts the occurrences of an element among its siblings, from its first occurrence till the end tag of parent.
+ *  It is a structural pre-pass: content and attributes are skipped without extracting or validating them,
+ *  and comments, CDATA sections and processing instructions are skipped as a whole.
+ *
+ * \param source const char* : Source XML string at the start tag ('<') of first occurrence
+ * \param end const char* const : End of source
+ * \param name const string_t* const : name of element
+ * \return uint32_t : number of occurrences. 0 if end tag of parent is not in the source.
+ */
+static uint32_t count_occurrence(const char* source, const char* const end, const string_t* const name)
+{
+  uint32_t count = 0;
+  uint32_t depth = 0;
+  while((source = memchr(source, '<', end - source)) != NULL)
+  {
+    if(++source == end)
+    {
+      return 0;
+    }
+
+    switch(*source)
+    {
+    case '?':
+      source = get_instruction_end(source - 1, end);
+      break;
+
+    case '!':
+      source = get_declaration_end(source - 1, end);
+      break;
+
+    case '/':
+      if(depth == 0)
+      {
+        return count;
+      }
+      depth--;
+      break;
+
+    default:
+      if((depth == 0) && ((size_t)(end - source) > name->Length) &&
+         (memcmp(source, name->String, name->Length) == 0) &&
+         scan_class_member(source[name->Length], &ELEMENT_NAME_END))
+      {
+        count++;
+      }
+
+      // Attribute value, quoted with '"' or '\'', may contain '>'.
+      const char* tag_end;
+      while((tag_end = memchr(source, '>', end - source)) != NULL)
+      {
+        const char* quote = memchr(source, '"', tag_end - source);
+        const char* const apostrophe = memchr(source, '\'', ((quote != NULL) ? quote : tag_end) - source);
+        if(apostrophe != NULL)
+        {
+          quote = apostrophe;
+        }
+        if(quote == NULL)
+        {
+          break;
+        }
+        source = memchr(quote + 1, *quote, end - quote - 1);
+        if(source == NULL)
+        {
+          return 0;
+        }
+        source++;
+      }
+      if(tag_end == NULL)
+      {
+        return 0;
+      }
+      if(tag_end[-1] != '/')
+      {
+        depth++;
+      }
+      source = tag_end + 1;
+      break;
+    }
+
+    if(source == NULL)
+    {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+/** \brief Get the address of an occurrence in the growable array. Array doubles its capacity when it is full.
+ *  With AllocateN callback, array is allocated once on the first occurrence for all the counted occurrences.
+ *  If occurrences are not counted, array is grown from the allocator of parser.
+ *
+ * \param address const target_address_t*const : target address of vector type.
+ * \param vector xml_vector_t* const : growable array of occurrences.
+ * \param occurrence uint32_t : occurrence of element in the XMl.
+ * \param count uint32_t : Number of occurrences counted by the pre-pass. 0 if not counted. Used only with AllocateN callback.
+ * \param allocator const xml_allocator_t* : allocator of parser.
+ * \param context void* : user defined context. Used only with AllocateN callback.
+ * \return void* : address of occurrence, cleared to zero. NULL if failed to allocate the array.
+ */
+static inline void* get_vector_element(const target_address_t* const address, xml_vector_t* const vector,
+                                       uint32_t occurrence, uint32_t count, const xml_allocator_t* allocator
+                                       CONTEXT_PTR)
+{
+  if(occurrence == 0)
+  {
+    vector->Data     = NULL;
+    vector->Count    = 0;
+    vector->Capacity = 0;
+    vector->Counted  = false;
+    if((address->AllocateN != NULL) && (count != 0))
+    {
+      vector->Data = address->AllocateN(count CONTEXT_ARG);
+      if(vector->Data == NULL)
+      {
+        return NULL;
+      }
+      vector->Capacity = count;
+      vector->Counted  = true;
+    }
+  }
+
+  if(occurrence >= vector->Capacity)
+  {
+    if(vector->Counted)
+    {
+      return NULL;
+    }
+
+    // Occurrence may be past the next doubling, e.g. when parser is restored from a checkpoint.
+    uint32_t capacity = vector->Capacity;
+    do
+    {
+      capacity = (capacity == 0) ? XML_PARSER_VECTOR_CAPACITY :
+                 (capacity > UINT32_MAX / 2) ? UINT32_MAX : (2 * capacity);
+    }while(capacity <= occurrence);
+
+    if((address->Size != 0) && (capacity > SIZE_MAX / address->Size))
+    {
+      return NULL;
+    }
+    void* const data = xml_reallocate(allocator, vector->Data, (size_t)vector->Capacity * address->Size,
+                                      (size_t)capacity * address->Size);
+    if(data == NULL)
+    {
+      return NULL;
+    }
+    vector->Data     = data;
+    vector->Capacity = capacity;
+  }
+
+  // Occurrences skipped by restoring the parser from a checkpoint are cleared too.
+  const uint32_t first = (vector->Count < occurrence) ? vector->Count : occurrence;
+  void* const element = (char*)vector->Data + ((size_t)occurrence * address->Size);
+  memset((char*)vector->Data + ((size_t)first * address->Size), 0, (size_t)(occurrence - first + 1) * address->Size);
+  vector->Count = occurrence + 1;
+  return element;
+}
+
+/** \brief Get the target address to store XML content based on address type.
+ *
+ * \param address const target_address_t*const : target address type.
+ * \param target void* : parent element target address. Used only in relative type of target address
+ * \param occurrence uint32_t : occurrence of element in the XMl.
+ * \param count uint32_t : Number of occurrences counted by the pre-pass. 0 if not counted.
+ *                         Used only in vector type with AllocateN callback.
+ * \param allocator const xml_allocator_t* : allocator of parser. used only in dynamic type without Allocate callback.
+ * \param context void* : user defined context. used only in dynamic type of target address.
+ * \return void* : Returns the target address to store XML content.
+ */
+static inline void* get_target_address(const target_address_t* const address,
+                                       void* target, uint32_t occurrence, uint32_t count,
+                                       const xml_allocator_t* allocator
+                                       CONTEXT_PTR)
+{
+  switch(address->Type)
+  {
+  case EN_STATIC:
+    return (void*)((size_t)(address->Address) + (occurrence * address->Size));
+
+  case EN_DYNAMIC:
+    if(address->Allocate == NULL)
+    {
+      target = xml_allocate(allocator, address->Size);
+      if(target != NULL)
+      {
+        memset(target, 0, address->Size);
+      }
+      return target;
+    }
+    return address->Allocate(occurrence CONTEXT_ARG);
+
+  case EN_RELATIVE:
+    return (void*)((size_t)(target) + (occurrence * address->Size) + address->Offset);
+
+  case EN_RECORD:
+    memset(address->Address, 0, address->Size);
+    return address->Address;
+
+  case EN_VECTOR:
+    return get_vector_element(address, (xml_vector_t*)((size_t)(target) + address->Offset),
+                              occurrence, count, allocator CONTEXT_ARG);
+
+  default:
+    return NULL;
+  }
+}
+
+#if XML_PARSER_LOOKUP
+/** \brief Returns the lookup of attributes of an open element, from the compiled schema if parser uses it.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param level const xml_parser_level_t* const : open element.
+ * \return const xs_lookup_t* : lookup of attributes. NULL if element doesn't have it.
+ */
+static inline const xs_lookup_t* get_attribute_lookup(const xml_parser_t* const parser,
+                                                      const xml_parser_level_t* const level)
+{
+#if XML_PARSER_COMPILE
+  if(parser->Compiled != NULL)
+  {
+    return &parser->Compiled->Attribute_Lookup[level->Node];
+  }
+#else
+  (void)parser;
+#endif // XML_PARSER_COMPILE
+  return level->Element->Attribute_Lookup;
+}
+#endif // XML_PARSER_LOOKUP
+
+/** \brief Returns the node of child element of an open element in the compiled schema.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param parent const xml_parser_level_t* const : open element.
+ * \param index uint32_t : index of child element.
+ * \return uint32_t : node of child element. 0 if parser doesn't use the compiled schema.
+ */
+static inline uint32_t get_child_node(const xml_parser_t* const parser,
+                                      const xml_parser_level_t* const parent, uint32_t index)
+{
+#if XML_PARSER_COMPILE
+  if(parser->Compiled != NULL)
+  {
+    return parser->Compiled->Child[parent->Node] + index;
+  }
+#else
+  (void)parser;
+  (void)parent;
+  (void)index;
+#endif // XML_PARSER_COMPILE
+  return 0;
+}
+
+/** \brief Verify that all the required attributes occurred in the XML element.
+ *  With attribute lookup, it compares the count of non optional attributes occurred with the count in the schema.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param level const xml_parser_level_t* const : XML element to verify
+ * \param attribute const uint32_t*const : Count of non optional attributes occurred followed by bit mask of occurred attributes.
+ * \return xml_parse_result_t result of validation.
+ */
+static inline xml_parse_result_t validate_attributes(const xml_parser_t* const parser,
+                                                     const xml_parser_level_t* const level,
+                                                     const uint32_t* const attribute)
+{
+  const xs_element_t* const element = level->Element;
+#if XML_PARSER_LOOKUP
+  const xs_lookup_t* const lookup = get_attribute_lookup(parser, level);
+  if((lookup != NULL) && (lookup->Quantity != 0) && (attribute[0] == lookup->Required))
+  {
+    return XML_PARSE_SUCCESS;
+  }
+#else
+  (void)parser;
+#endif // XML_PARSER_LOOKUP
+
+  for(uint32_t i = 0; i < element->Attribute_Quantity; i++)
+  {
+    ASSERT((((attribute[1 + i / 32] >> (i % 32)) & 1) || element->Attribute[i].Use == EN_OPTIONAL),
+           XML_ATTRIBUTE_NOT_FOUND,
+           "required attribute '%s' not found\n", element->Attribute[i].Name.String);
+  }
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Validate an empty element.
+ *
+ * \param element const xs_element_t*const : element to validate.
+ * \return xml_parse_result_t result of validation.
+ */
+static inline xml_parse_result_t validate_empty_element(const xs_element_t* const element)
+{
+  for(uint32_t i = 0; i < element->Child_Quantity; i++)
+  {
+    ASSERT((!element->Child[i].MinOccur), XML_ELEMENT_MIN_OCCURRENCE_ERR,
+           "XML element '%s' occurred less than specified count %d in the schema\n",
+           element->Child[i].Name.String, element->Child[i].MinOccur);
+  }
+
+  ASSERT((element->Content.Type == EN_NO_XML_DATA_TYPE), XML_CONTENT_ERROR,
+         "XML element '%s' does not contains content as specified in the schema.\n", element->Name.String);
+
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Validate that in case of child element order is specified as choice then
+ * only one child element can be present.(Though it can have multiple
+ * occurrence of that element as specified in the maxOccur)
+ *
+ * \param occurrence uint32_t* : pointer to array of occurrence table
+ * \param quantity size_t : Number of child elements
+ * \return bool : return true if only on child element occurred otherwise false.
+ */
+static inline bool validate_choice_order(uint32_t* occurrence, size_t quantity)
+{
+  uint32_t count = 0;
+  for(uint32_t i = 0; i < quantity; i++)
+  {
+    if(occurrence[i])
+    {
+      if(++count > 1)
+      {
+        return false;   // More than one child elements found
+      }
+    }
+  }
+  return true;
+}
+
+/** \brief validate the XML element. Check for matching end element tag.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param element const xs_element_t*const : element to validate.
+ * \param input const char** : Input XML string.
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of element validation
+ */
+static inline xml_parse_result_t validate_element(const xml_parser_t* const parser,
+                                                  const xs_element_t* const element,
+                                                  const char** input, const char* const end)
+{
+  const char* const tag = *input;
+  const char* source = tag + element->Name.Length;
+  // End tag usually matches the open element, then its name needn't be scanned for the end.
+  if(!match_token(tag, end, element->Name.String, element->Name.Length) || (source == end) ||
+     !scan_class_member(*source, &ELEMENT_NAME_END))
+  {
+    source = get_element_end_tag(parser, tag, end);
+    ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end tag of element.\n");
+    size_t length = source - tag;
+
+    ASSERT((length == element->Name.Length) && (strncmp(element->Name.String, tag, length) == 0),
+           XML_END_TAG_NOT_FOUND,
+           "End tag '%.*s' does not match with start tag '%s' of an element.\n", (int)length, tag, element->Name.String);
+  }
+
+  ASSERT_TOKEN(source, end, '>');
+  *input = source;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Extracts the XML content to the target address. In case of XML reader
+ * it extracts the content to the value of reader event instead of target address.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param content const xml_content_t* const : XML content type.
+ * \param target void* : Target address to store the extracted content.
+ * \param source const char* : Source XML content to extract
+ * \param length size_t : Length of XML content
+ * \return xml_parse_result_t : result of content extraction.
+ */
+static inline xml_parse_result_t extract_value(const xml_parser_t* const parser,
+                                               const xml_content_t* const content,
+                                               void* target, const char* source, size_t length)
+{
+  if(parser->Event == NULL)
+  {
+    return extract_content_allocator(content, target, source, length, parser->Allocator);
+  }
+
+  xml_value_t* const value = &parser->Event->Value;
+  switch(content->Type)
+  {
+  case EN_NO_XML_DATA_TYPE:
+    value->String.String = (char*)source;
+    value->String.Length = length;
+    return XML_PARSE_SUCCESS;
+
+  case EN_STRING_DYNAMIC:
+  case EN_CHAR_ARRAY:
+    {
+      // Reader doesn't copy the string content.
+      const xml_content_t string = {.Type = EN_STRING, .Facet.String = content->Facet.String};
+      return extract_content(&string, value, source, length);
+    }
+
+  default:
+    return extract_content(content, value, source, length);
+  }
+}
+
+/** \brief Opens the XML element on the parser stack on its start tag.
+ *
+ * \param parser xml_parser_t* const : XML parser. Top of the stack is parent of the element.
+ * \param element const xs_element_t* const : XML element to open.
+ * \param node uint32_t : Node of the element in the compiled schema.
+ * \param target void* : Target address of the element.
+ * \return xml_parse_result_t : XML_PARSER_STACK_OVERFLOW if parser stack is full.
+ */
+static inline xml_parse_result_t open_element(xml_parser_t* const parser,
+                                              const xs_element_t* const element, uint32_t node,
+                                              void* target)
+{
+  const xml_parser_level_t* const parent = &parser->Level[parser->Depth - 1];
+  const uint32_t index = parent->Occurrence + parent->Element->Child_Quantity +
+                         ATTRIBUTE_WORDS(parent->Element->Attribute_Quantity);
+  const uint32_t quantity = element->Child_Quantity + ATTRIBUTE_WORDS(element->Attribute_Quantity);
+  ASSERT((parser->Depth < XML_PARSER_MAX_DEPTH) && (index + quantity <= XML_PARSER_MAX_OCCURRENCE),
+         XML_PARSER_STACK_OVERFLOW, "XML element '%s' is nested deeper than parser stack. "
+         "Raise XML_PARSER_MAX_DEPTH or XML_PARSER_MAX_OCCURRENCE.\n",
+         element->Name.String);
+
+  xml_parser_level_t* const level = &parser->Level[parser->Depth++];
+  level->Element    = element;
+  level->Target     = target;
+  level->Occurrence = index;
+  level->Index      = 0;
+  level->Node       = node;
+  for(uint32_t i = 0; i < quantity; i++)
+  {
+    parser->Occurrence[index + i] = 0;
+  }
+  parser->State = EN_PARSE_ATTRIBUTE;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Closes the open XML element, triggers the callback on its completion and
+ *         updates the parser state to parse the next sibling element.
+ *
+ * \param parser xml_parser_t* const : XML parser. Top of the stack is the completed element.
+ */
+static inline void close_element(xml_parser_t* const parser)
+{
+  const xml_parser_level_t* const level = &parser->Level[--parser->Depth];
+  const xml_parser_level_t* const parent = &parser->Level[parser->Depth - 1];
+  const uint32_t occurrence = parser->Occurrence[parent->Occurrence + parent->Index];
+
+  if(parser->Event != NULL)
+  {
+    parser->Event->Type       = EN_EVENT_END;
+    parser->Event->Element    = level->Element;
+    parser->Event->Occurrence = occurrence;
+  }
+#if XML_PARSER_CALLBACK
+  else if(level->Element->Callback)
+  {
+    level->Element->Callback(occurrence, level->Target PARSER_CONTEXT_ARG);
+  }
+#endif // XML_PARSER_CALLBACK
+
+  parser->State = (parent->Element == &parser->Document) ? EN_PARSE_COMPLETE : EN_PARSE_CHILD;
+}
+
+/** \brief Validates the end tag of an open element and closes it.
+ *
+ * \param parser xml_parser_t* const : XML parser. Top of the stack is the open element.
+ * \param input const char** : Input XML string after "</".
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static inline xml_parse_result_t parse_end_tag(xml_parser_t* const parser,
+                                               const char** input, const char* const end)
+{
+  ASSERT_RESULT(validate_element(parser, parser->Level[parser->Depth - 1].Element, input, end));
+  close_element(parser);
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Parses XML attribute and extracts the content of attribute
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param attribute const xs_attribute_t*const : Structure defining XML attribute to parse.
+ * \param input const char** : input XML string to parse and extract the content of attribute
+ * \param end const char* const : End of XML string.
+ * \param target void* : Target address to store XMl content
+ * \return xml_parse_result_t result of parsing
+ */
+static inline xml_parse_result_t parse_attribute(const xml_parser_t* const parser,
+                                                 const xs_attribute_t* const attribute,
+                                                 const char** input, const char* const end,
+                                                 void* target)
+{
+  const char* source = *input;
+
+  ASSERT_TOKEN(source, end, '=');
+  ASSERT_TOKEN(source, end, '"');
+
+  const char* const tag = source;
+  uint32_t text = 0;
+  source = get_text_end(parser, source, end, '"', &text);
+  ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");
+  size_t length = source++ - tag;
+  *input = source;
+
+  if(parser->Event != NULL)
+  {
+    parser->Event->Text = text;
+    target = NULL;
+  }
+  else
+  {
+    target = get_target_address(&attribute->Target, target, 0, 0, parser->Allocator PARSER_CONTEXT_ARG);
+  }
+  return extract_value(parser, &attribute->Content, target, tag, length);
+}
+
+/** \brief parses next attribute or end of start tag of an open element
+ *         as specified in the given xs_element_t.
+ *
+ * \param parser xml_parser_t* const : XML parser. Top of the stack is the open element.
+ * \param input const char** : Input XML string to parse
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static inline xml_parse_result_t parse_element(xml_parser_t* const parser,
+                                               const char** input, const char* const end)
+{
+  const xml_parser_level_t* const level = &parser->Level[parser->Depth - 1];
+  const xs_element_t* const element = level->Element;
+  uint32_t* const attribute = &parser->Occurrence[level->Occurrence + element->Child_Quantity];
+  const char* source = *input;
+
+  source = skip_whitespace(source, end);
+  ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");
+
+  switch(*source)
+  {
+  case '/':
+    source++;
+    ASSERT((source < end), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");
+    ASSERT((*source++ == '>'), XML_SYNTAX_ERROR, "XML is not well formed. Missing '>' after '/'.\n");
+    ASSERT_RESULT(validate_attributes(parser, level, attribute));
+    ASSERT_RESULT(validate_empty_element(element));
+    *input = source;
+    close_element(parser);
+    return XML_PARSE_SUCCESS;
+
+  case '>':
+    ASSERT_RESULT(validate_attributes(parser, level, attribute));
+    if(element->Child_Quantity > 0)
+    {
+      parser->State = EN_PARSE_CHILD;
+    }
+    else if(element->Content.Type != EN_NO_XML_DATA_TYPE)
+    {
+      parser->State = EN_PARSE_CONTENT;
+    }
+    else
+    {
+      parser->State = EN_PARSE_END_TAG;
+    }
+    *input = ++source;
+    return XML_PARSE_SUCCESS;
+  }
+
+  ASSERT(element->Attribute_Quantity > 0, XML_SYNTAX_ERROR,
+         "XML is not well formed. Missing end tag of element '%s'.\n", element->Name.String);
+
+  const char* const tag = source;
+  source = get_attribute_tag(parser, source, end);
+  ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing element '%s' attribute\n",
+         element->Name.String);
+  size_t length = source - tag;
+  uint32_t i = 0;
+#if XML_PARSER_LOOKUP
+  const xs_lookup_t* const lookup = get_attribute_lookup(parser, level);
+  if((lookup != NULL) && (lookup->Quantity != 0))
+  {
+    i = lookup_hash(lookup, get_name_hash(tag, length));
+    ASSERT((length == element->Attribute[i].Name.Length) &&
+           (memcmp(tag, element->Attribute[i].Name.String, length) == 0), XML_ATTRIBUTE_NOT_FOUND,
+           "Undefined attribute tag '%.*s' in the element '%s'\n", (int)length, tag, element->Name.String);
+  }
+  else
+#endif // XML_PARSER_LOOKUP
+  while((length != element->Attribute[i].Name.Length) ||
+        (strncmp(tag, element->Attribute[i].Name.String, length) != 0))
+  {
+    ASSERT(++i < element->Attribute_Quantity, XML_ATTRIBUTE_NOT_FOUND,
+           "Undefined attribute tag '%.*s' in the element '%s'\n", (int)length, tag, element->Name.String);
+  }
+
+  uint32_t* const presence = &attribute[1 + i / 32];
+  const uint32_t bit = 1U << (i % 32);
+  ASSERT(!(*presence & bit), XML_DUPLICATE_ATTRIBUTE,
+         "Duplicate attribute '%s' found in the element '%s'.\n",
+         element->Attribute[i].Name.String, element->Name.String);
+  *presence |= bit;
+  if(element->Attribute[i].Use != EN_OPTIONAL)
+  {
+    attribute[0]++;
+  }
+
+  ASSERT_RESULT(parse_attribute(parser, &element->Attribute[i], &source, end, level->Target));
+  if(parser->Event != NULL)
+  {
+    parser->Event->Type      = EN_EVENT_ATTRIBUTE;
+    parser->Event->Element   = element;
+    parser->Event->Attribute = &element->Attribute[i];
+  }
+  *input = source;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Parses the content of an open element that doesn't have child elements.
+ *
+ * \param parser xml_parser_t* const : XML parser. Top of the stack is the open element.
+ * \param input const char** : input XML string to parse
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static inline xml_parse_result_t parse_content(xml_parser_t* const parser,
+                                               const char** input, const char* const end)
+{
+  const xml_parser_level_t* const level = &parser->Level[parser->Depth - 1];
+  const xs_element_t* const element = level->Element;
+  const char* content = *input;
+
+  uint32_t text = 0;
+  const char* source = get_text_end(parser, content, end, '<', &text);
+  ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end tag of element '%s'\n",
+         element->Name.String);
+  size_t length = source - content;
+
+  // Content of CDATA section is extracted as it is from the source.
+  if(match_token(source, end, "<![CDATA[", sizeof("<![CDATA[") - 1) && (skip_whitespace(content, source) == NULL))
+  {
+    content = source + (sizeof("<![CDATA[") - 1);
+    text = 0;
+    source = get_text_terminator(content, end, "]]>", sizeof("]]>") - 1, &text);
+    ASSERT((source != NULL), XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end of CDATA section in element '%s'\n",
+           element->Name.String);
+    text   = (text & ~EN_TEXT_ENTITY) | EN_TEXT_CDATA;
+    length = source - content;
+    source += sizeof("]]>") - 1;
+  }
+
+  ASSERT_RESULT(extract_value(parser, &element->Content, level->Target, content, length));
+  if(parser->Event != NULL)
+  {
+    parser->Event->Type    = EN_EVENT_CONTENT;
+    parser->Event->Element = element;
+    parser->Event->Text    = text;
+  }
+  parser->State = EN_PARSE_END_TAG;
+  *input = source;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Parses the end tag of an open element that doesn't have child elements.
+ *
+ * \param parser xml_parser_t* const : XML parser. Top of the stack is the open element.
+ * \param input const char** : input XML string to parse
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static inline xml_parse_result_t parse_element_end(xml_parser_t* const parser,
+                                                   const char** input, const char* const end)
+{
+  const char* source = *input;
+  ASSERT_TOKEN(source, end, '<');
+  ASSERT((source < end), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");
+  ASSERT(*source++ == '/', XML_SYNTAX_ERROR, "XML is not well formed. Missing '/' after '<'.\n");
+  ASSERT_RESULT(parse_end_tag(parser, &source, end));
+  *input = source;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Skips the rest of comment or processing instruction till its terminator.
+ *  On end of source only the chars that may start the terminator are left in the input,
+ *  so that markup split across chunks is skipped without holding it in the parser buffer.
+ *
+ * \param parser xml_parser_t* const : XML parser.
+ * \param input const char** : input XML string inside the markup.
+ * \param end const char* const : End of XML string.
+ * \param token const char* const : terminator of markup ("-->" or "?>")
+ * \param length size_t : length of terminator
+ * \return xml_parse_result_t : XML_INCOMPLETE_SOURCE if terminator is not in the source.
+ */
+static inline xml_parse_result_t skip_markup(xml_parser_t* const parser,
+                                             const char** input, const char* const end,
+                                             const char* const token, size_t length)
+{
+  const char* const source = get_terminator(*input, end, token, length);
+  if((source == NULL) && ((size_t)(end - *input) > length - 1))
+  {
+    *input = end - (length - 1);
+  }
+  ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing \"%s\".\n", token);
+  parser->State = EN_PARSE_CHILD;
+  *input = source + length;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Skips the rest of DOCTYPE declaration. Its scan state is held in the parser,
+ *  so that declaration split across chunks is skipped without holding it in the parser buffer.
+ *
+ * \param parser xml_parser_t* const : XML parser.
+ * \param input const char** : input XML string inside the declaration.
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : XML_INCOMPLETE_SOURCE if end of declaration is not in the source.
+ */
+static inline xml_parse_result_t skip_doctype(xml_parser_t* const parser,
+                                              const char** input, const char* const end)
+{
+  const char* const source = get_doctype_end(input, end, &parser->Doctype_Depth, &parser->Doctype_Delimiter);
+  ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end of DOCTYPE.\n");
+  parser->State = EN_PARSE_CHILD;
+  *input = source;
+  return XML_PARSE_SUCCESS;
+}
+
+#if XML_PARSER_COMPILE
+/** \brief Matches the name of a node of compiled schema, comparing its length and first 8 bytes
+ *  before the rest of the name.
+ *
+ * \param compiled const xs_compiled_t* const : compiled schema
+ * \param node uint32_t : node to match
+ * \param tag const char* : name in the XML source
+ * \param length size_t : length of name
+ * \param prefix uint64_t : first 8 bytes of name (\ref get_name_prefix)
+ * \return bool : true if name matches with the node.
+ */
+static inline bool match_compiled_name(const xs_compiled_t* const compiled, uint32_t node,
+                                       const char* tag, size_t length, uint64_t prefix)
+{
+  return (compiled->Name_Length[node] == length) && (compiled->Name_Prefix[node] == prefix) &&
+         ((length <= 8) || (memcmp(tag + 8, compiled->Element[node]->Name.String + 8, length - 8) == 0));
+}
+
+/** \brief Finds the child element of an open element in the compiled schema.
+ *
+ * \param compiled const xs_compiled_t* const : compiled schema
+ * \param level const xml_parser_level_t* const : open element
+ * \param occurrence const uint32_t* const : occurrence table of child elements of open element
+ * \param tag const char* : name of child element in the XML source
+ * \param length size_t : length of name
+ * \param index uint32_t* const : index of child element to start matching from. Updated to the matched child element.
+ * \return xml_parse_result_t : result of matching.
+ */
+static inline xml_parse_result_t find_compiled_child(const xs_compiled_t* const compiled,
+                                                     const xml_parser_level_t* const level,
+                                                     const uint32_t* const occurrence,
+                                                     const char* tag, size_t length, uint32_t* const index)
+{
+  const uint32_t first = compiled->Child[level->Node];
+  const uint64_t prefix = get_name_prefix(tag, length);
+  const xs_lookup_t* const lookup = &compiled->Child_Lookup[level->Node];
+  uint32_t i = *index;
+
+  if(lookup->Quantity != 0)
+  {
+    i = lookup_hash(lookup, get_name_hash(tag, length));
+    ASSERT(match_compiled_name(compiled, first + i, tag, length, prefix),
+           XML_ELEMENT_NOT_FOUND_ERR, "Undefined XML element '%.*s'\n", (int)length, tag);
+  }
+  else
+  {
+    while(!match_compiled_name(compiled, first + i, tag, length, prefix))
+    {
+      if(level->Element->Child_Order == EN_SEQUENCE)
+      {
+        ASSERT(occurrence[i] >= compiled->Min_Occur[first + i], XML_ELEMENT_MIN_OCCURRENCE_ERR,
+               "XML element '%s' occurred less than specified count %d in the schema\n",
+               compiled->Element[first + i]->Name.String, compiled->Min_Occur[first + i]);
+      }
+      ASSERT(++i < compiled->Child_Quantity[level->Node], XML_ELEMENT_NOT_FOUND_ERR,
+             "Undefined XML element '%.*s'\n", (int)length, tag);
+    }
+  }
+  *index = i;
+  return XML_PARSE_SUCCESS;
+}
+#endif // XML_PARSER_COMPILE
+
+/** \brief Finds the child element of an open element by its name.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param level const xml_parser_level_t* const : open element
+ * \param occurrence const uint32_t* const : occurrence table of child elements of open element
+ * \param tag const char* : name of child element in the XML source
+ * \param length size_t : length of name
+ * \param index uint32_t* const : index of last parsed child element. Updated to the matched child element.
+ * \return xml_parse_result_t : result of matching.
+ */
+static inline xml_parse_result_t find_child_element(const xml_parser_t* const parser,
+                                                    const xml_parser_level_t* const level,
+                                                    const uint32_t* const occurrence,
+                                                    const char* tag, size_t length, uint32_t* const index)
+{
+  const xs_element_t* const parent = level->Element;
+  uint32_t element_index = *index;
+  if(parent->Child_Order != EN_SEQUENCE)
+  {
+    element_index = 0;
+  }
+#if XML_PARSER_COMPILE
+  if(parser->Compiled != NULL)
+  {
+    ASSERT_RESULT(find_compiled_child(parser->Compiled, level, occurrence, tag, length, &element_index));
+  }
+  else
+#else
+  (void)parser;
+#endif // XML_PARSER_COMPILE
+#if XML_PARSER_LOOKUP
+  if((parent->Child_Order != EN_SEQUENCE) && (parent->Child_Lookup != NULL) &&
+     (parent->Child_Lookup->Quantity != 0))
+  {
+    element_index = lookup_hash(parent->Child_Lookup, get_name_hash(tag, length));
+    ASSERT((length == parent->Child[element_index].Name.Length) &&
+           (memcmp(tag, parent->Child[element_index].Name.String, length) == 0),
+           XML_ELEMENT_NOT_FOUND_ERR, "Undefined XML element '%.*s'\n", (int)length, tag);
+  }
+  else
+#endif // XML_PARSER_LOOKUP
+  while(1)
+  {
+    if((length == parent->Child[element_index].Name.Length) &&
+      (strncmp(tag, parent->Child[element_index].Name.String, length) == 0))
+    {
+      break;
+    }
+
+    if(parent->Child_Order == EN_SEQUENCE)
+    {
+      ASSERT(occurrence[element_index] >= parent->Child[element_index].MinOccur,
+              XML_ELEMENT_MIN_OCCURRENCE_ERR,
+              "XML element '%s' occurred less than specified count %d in the schema\n",
+              parent->Child[element_index].Name.String, parent->Child[element_index].MinOccur);
+    }
+    ASSERT(++element_index < parent->Child_Quantity, XML_ELEMENT_NOT_FOUND_ERR,
+           "Undefined XML element '%.*s'\n", (int)length, tag);
+  }
+  *index = element_index;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Compares the source with the name of a child element followed by the end of name,
+ *  without scanning the source for the end of name.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param level const xml_parser_level_t* const : open element
+ * \param index uint32_t : index of child element
+ * \param tag const char* : start of name in the XML source
+ * \param end const char* const : End of XML string.
+ * \return bool : true if source starts with the name of child element.
+ */
+static inline bool match_predicted_child(const xml_parser_t* const parser, const xml_parser_level_t* const level,
+                                         uint32_t index, const char* tag, const char* const end)
+{
+#if XML_PARSER_COMPILE
+  if(parser->Compiled != NULL)
+  {
+    // Names of up to 16 bytes are compared with one or two word loads.
+    const xs_compiled_t* const compiled = parser->Compiled;
+    const uint32_t node = compiled->Child[level->Node] + index;
+    const size_t length = compiled->Name_Length[node];
+    uint64_t word;
+    if((size_t)(end - tag) <= ((length > 8) ? length : 8))
+    {
+      return false;
+    }
+
+    memcpy(&word, tag, 8);
+    if((word & compiled->Name_Mask[node]) != compiled->Name_Prefix[node])
+    {
+      return false;
+    }
+
+    if(length > 8)
+    {
+      memcpy(&word, tag + length - 8, 8);
+      if((word != compiled->Name_Suffix[node]) ||
+         ((length > 16) && (memcmp(tag + 8, compiled->Element[node]->Name.String + 8, length - 16) != 0)))
+      {
+        return false;
+      }
+    }
+    return scan_class_member(tag[length], &ELEMENT_NAME_END);
+  }
+#else
+  (void)parser;
+#endif // XML_PARSER_COMPILE
+
+  const string_t* const name = &level->Element->Child[index].Name;
+  return ((size_t)(end - tag) > name->Length) && (*tag == *name->String) &&
+         (memcmp(tag, name->String, name->Length) == 0) && scan_class_member(tag[name->Length], &ELEMENT_NAME_END);
+}
+
+/** \brief Predicts the next child element of sequence order: the last parsed child element occurring again,
+ *  or its next sibling. Source generated in schema order then needs no scan for the end of name.
+ *  Prediction is same as matching the child elements in sequence from the last parsed child element.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param level const xml_parser_level_t* const : open element of sequence order
+ * \param occurrence const uint32_t* const : occurrence table of child elements of open element
+ * \param tag const char* : start of name in the XML source
+ * \param end const char* const : End of XML string.
+ * \param index uint32_t* const : Updated to the predicted child element if it matches.
+ * \return bool : true if predicted child element matches.
+ */
+static inline bool predict_sequence_child(const xml_parser_t* const parser, const xml_parser_level_t* const level,
+                                          const uint32_t* const occurrence, const char* tag,
+                                          const char* const end, uint32_t* const index)
+{
+  const xs_element_t* const parent = level->Element;
+  const uint32_t i = level->Index;
+  if(match_predicted_child(parser, level, i, tag, end))
+  {
+    *index = i;
+    return true;
+  }
+
+  if((i + 1 < parent->Child_Quantity) && (occurrence[i] >= parent->Child[i].MinOccur) &&
+     match_predicted_child(parser, level, i + 1, tag, end))
+  {
+    *index = i + 1;
+    return true;
+  }
+  return false;
+}
+
+/** \brief Parses a XML source to extract next child element (or end tag) of an open element
+ * as specified in the xs_element_t schema.
+ *
+ * \param parser xml_parser_t* const : XML parser. Top of the stack is the open element.
+ * \param input const char** : input XML string to parse
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static inline xml_parse_result_t parse_parent_element(xml_parser_t* const parser,
+                                                      const char** input, const char* const end)
+{
+  xml_parser_level_t* const level = &parser->Level[parser->Depth - 1];
+  const xs_element_t* const parent = level->Element;
+  uint32_t* const occurrence = &parser->Occurrence[level->Occurrence];
+  const char* source = *input;
+
+  ASSERT_TOKEN(source, end, '<');
+  ASSERT((source < end), XML_INCOMPLETE_SOURCE, "Incomplete XML source.\n");
+
+  switch(*source)
+  {
+  // Processing instruction, comment and DOCTYPE declaration are skipped by their own states,
+  // so that their end needn't be in the same chunk.
+  case '?':
+    parser->State = EN_PARSE_INSTRUCTION;
+    *input = source + 1;
+    return XML_PARSE_SUCCESS;
+
+  case '!':
+    if(match_token(source - 1, end, "<!--", sizeof("<!--") - 1))
+    {
+      parser->State = EN_PARSE_COMMENT;
+      *input = source + (sizeof("<!--") - 2);
+      return XML_PARSE_SUCCESS;
+    }
+    if(match_token(source - 1, end, "<!DOCTYPE", sizeof("<!DOCTYPE") - 1))
+    {
+      parser->State = EN_PARSE_DOCTYPE;
+      parser->Doctype_Depth     = 0;
+      parser->Doctype_Delimiter = 0;
+      *input = source + (sizeof("<!DOCTYPE") - 2);
+      return XML_PARSE_SUCCESS;
+    }
+    source = get_declaration_end(source - 1, end);
+    ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end of comment, CDATA or DOCTYPE.\n");
+    *input = source;
+    return XML_PARSE_SUCCESS;
+
+  case '/':
+    for(uint32_t i = 0; i < parent->Child_Quantity; i++)
+    {
+      ASSERT(occurrence[i] >= parent->Child[i].MinOccur, XML_ELEMENT_MIN_OCCURRENCE_ERR,
+             "XML element '%s' occurred less than specified count %d in the schema\n",
+             parent->Child[i].Name.String, parent->Child[i].MinOccur);
+    }
+    source++;
+    ASSERT_RESULT(parse_end_tag(parser, &source, end));
+    *input = source;
+    return XML_PARSE_SUCCESS;
+  }
+
+  const char* const tag = source;
+  uint32_t element_index = level->Index;
+  if((parent->Child_Order == EN_SEQUENCE) && predict_sequence_child(parser, level, occurrence, tag, end, &element_index))
+  {
+    source = tag + parent->Child[element_index].Name.Length;
+  }
+  else
+  {
+    source = get_element_end_tag(parser, source, end);
+    ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end tag (/>) of element '%s'.\n",
+           parent->Name.String);
+    ASSERT_RESULT(find_child_element(parser, level, occurrence, tag, source - tag, &element_index));
+  }
+  level->Index = element_index;
+
+  const xs_element_t* const element = &parent->Child[element_index];
+  ASSERT(occurrence[element_index] < element->MaxOccur, XML_ELEMENT_MAX_OCCURRENCE_ERR,
+         "XML element '%s' occurred more than specified count %d in the schema.\n",
+         element->Name.String, element->MaxOccur);
+
+  void* target = NULL;
+  if(parser->Event == NULL)
+  {
+    uint32_t count = 0;
+    if((element->Target.Type == EN_VECTOR) && (element->Target.AllocateN != NULL) && (occurrence[element_index] == 0))
+    {
+      // Source fed in chunks may not have the end tag of parent, then count is 0 and array is grown instead.
+      count = count_occurrence(tag - 1, end, &element->Name);
+      if(count > element->MaxOccur)
+      {
+        count = element->MaxOccur;
+      }
+    }
+    target = get_target_address(&element->Target, level->Target, occurrence[element_index], count,
+                                parser->Allocator PARSER_CONTEXT_ARG);
+    ASSERT((target != NULL) || !((element->Target.Type == EN_VECTOR) ||
+                                 ((element->Target.Type == EN_DYNAMIC) && (element->Target.Allocate == NULL))),
+           FAILED_TO_ALLOCATE_MEMORY, "Failed to allocate target of XML element '%s'.\n", element->Name.String);
+  }
+  occurrence[element_index]++;
+
+  if(parent->Child_Order == EN_CHOICE)
+  {
+    ASSERT(validate_choice_order(occurrence, parent->Child_Quantity), XML_CHOICE_ELEMENT_ERR,
+           "XML element '%s' of type choice contains more than one child element\n", parent->Name.String);
+  }
+
+  ASSERT_RESULT(open_element(parser, element, get_child_node(parser, level, element_index), target));
+  if(parser->Event != NULL)
+  {
+    parser->Event->Type       = EN_EVENT_START;
+    parser->Event->Element    = element;
+    parser->Event->Occurrence = occurrence[element_index];
+  }
+  *input = source;
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Finds the end of next token (markup, attribute or content) of XML source.
+ * Used to check that the complete token is available in the source before parsing it,
+ * so that parser can resume the parsing of an incomplete token on the next chunk.
+ *
+ * \param parser const xml_parser_t* const : XML parser.
+ * \param source const char* : input XML string.
+ * \param end const char* const : End of XML string.
+ * \return const char* : returns end of token or NULL if token is incomplete.
+ */
+static inline const char* get_token_end(const xml_parser_t* const parser,
+                                        const char* source, const char* const end)
+{
+  switch(parser->State)
+  {
+  case EN_PARSE_CHILD:
+    source = skip_whitespace(source, end);
+    if((source == NULL) || (end - source < 2))
+    {
+      return NULL;
+    }
+    if(*source != '<')
+    {
+      return source + 1;    // Parser reports the syntax error.
+    }
+
+    switch(source[1])
     {
-      if((length == element->Attribute[i].Name.Length) &&
-         (strncmp(tag, element->Attribute[i].Name.String, length) == 0))
+    case '?':
+      return source + (sizeof("<?") - 1);   // Rest of processing instruction is skipped incrementally.
+
+    case '!':
+      // Rest of comment and DOCTYPE declaration is skipped incrementally.
+      if(match_token(source, end, "<!--", sizeof("<!--") - 1))
       {
-        ASSERT(!occurrence[i], XML_DUPLICATE_ATTRIBUTE,
-               "Duplicate attribute '%s' found in the element '%s'.\n",
-               element->Attribute[i].Name.String, element->Name.String);
+        return source + (sizeof("<!--") - 1);
+      }
+      if(match_token(source, end, "<!DOCTYPE", sizeof("<!DOCTYPE") - 1))
+      {
+        return source + (sizeof("<!DOCTYPE") - 1);
+      }
+      return get_declaration_end(source, end);
+
+    case '/':
+      source = memchr(source, '>', end - source);
+      return (source != NULL) ? source + 1 : NULL;
+
+    default:
+      return get_element_end_tag(parser, source + 1, end);
+    }
 
-        occurrence[i] = true;
-        *input = source;
-        ASSERT_RESULT(parse_attribute(&element->Attribute[i], input, target CONTEXT_ARG));
-        source = *input;
-        attribute_occurred++;
-        break;
+  case EN_PARSE_ATTRIBUTE:
+    source = skip_whitespace(source, end);
+    if(source == NULL)
+    {
+      return NULL;
+    }
+    switch(*source)
+    {
+    case '>':
+      return source + 1;
+
+    case '/':
+      return (end - source < 2) ? NULL : source + 2;
+
+    default:
+      // Attribute value is enclosed in quotes after '='. Parser reports the syntax error of any other char at once.
+      source = get_attribute_tag(parser, source, end);
+      if((source == NULL) || ((source = skip_whitespace(source, end)) == NULL))
+      {
+        return NULL;
+      }
+      if(*source++ != '=')
+      {
+        return source;
+      }
+      source = skip_whitespace(source, end);
+      if(source == NULL)
+      {
+        return NULL;
+      }
+      if(*source++ != '"')
+      {
+        return source;
       }
+      source = memchr(source, '"', end - source);
+      return (source != NULL) ? source + 1 : NULL;
+    }
+
+  case EN_PARSE_CONTENT:
+  {
+    source = memchr(source, '<', end - source);
+    if(source == NULL)
+    {
+      return NULL;
+    }
 
-      ASSERT(++i < element->Attribute_Quantity, XML_ATTRIBUTE_NOT_FOUND,
-             "Undefined attribute tag '%.*s' in the element '%s'\n", (int)length, tag, element->Name.String);
+    const size_t length = end - source;
+    if(length < sizeof("<![CDATA[") - 1)
+    {
+      // Wait for the rest of the source if it could be start of CDATA section.
+      return (memcmp(source, "<![CDATA[", length) == 0) ? NULL : source;
     }
+    if(memcmp(source, "<![CDATA[", sizeof("<![CDATA[") - 1) != 0)
+    {
+      return source;
+    }
+
+    source = get_terminator(source + (sizeof("<![CDATA[") - 1), end, "]]>", sizeof("]]>") - 1);
+    return (source != NULL) ? source + (sizeof("]]>") - 1) : NULL;
+  }
+
+  case EN_PARSE_END_TAG:
+    source = memchr(source, '>', end - source);
+    return (source != NULL) ? source + 1 : NULL;
+
+  default:
+    return source;
   }
 }
 
-/** \brief Parses a XML source to extract child elements from parent element
- * as specified in the xs_element_t schema.
+/** \brief Checks the incomplete content of an open element against the maximum length of its string content,
+ *  so that the parser buffer needs to hold the content only up to its maximum length.
  *
- * \param parent const xs_element_t*const : : Schema of parent element
- * \param input const char** : input XML string to parse
- * \param parent_target void* : Target address of parent element. It is used for
- * for calculating the target address of child element if it's address type is relative.
- * \param context void* : User specified context.
- * \return xml_parse_result_t : result of parsing.
+ * \param parser const xml_parser_t* const : XML parser. Top of the stack is the open element.
+ * \param source const char* : incomplete content.
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : XML_MAX_LENGTH_ERROR if content is already longer than its maximum length.
  */
-static inline xml_parse_result_t parse_parent_element(const xs_element_t* const parent,
-                                                      const char** input,
-                                                      void* parent_target
-                                                      CONTEXT_PTR)
+static inline xml_parse_result_t validate_partial_content(const xml_parser_t* const parser,
+                                                          const char* source, const char* const end)
 {
-  uint32_t occurrence[parent->Child_Quantity];
-  uint32_t element_index = 0;
-  const char* source = *input;
+  const xml_parser_level_t* const level = &parser->Level[parser->Depth - 1];
+  const xml_content_t* const content = &level->Element->Content;
+  if(((content->Type != EN_STRING) && (content->Type != EN_STRING_DYNAMIC) && (content->Type != EN_CHAR_ARRAY)) ||
+     ((level->Target == NULL) && (parser->Event == NULL)))
+  {
+    return XML_PARSE_SUCCESS;
+  }
 
-  for(uint32_t i = 0; i < parent->Child_Quantity; i++)
+  const char* const markup = memchr(source, '<', end - source);
+  size_t length = ((markup != NULL) ? markup : end) - source;
+  if(skip_whitespace(source, source + length) == NULL)
   {
-    occurrence[i] = 0;
+    // Only whitespace so far, content is the CDATA section that may follow it.
+    if((markup == NULL) || !match_token(markup, end, "<![CDATA[", sizeof("<![CDATA[") - 1))
+    {
+      return XML_PARSE_SUCCESS;
+    }
+    length = end - markup - (sizeof("<![CDATA[") - 1);
+    length = (length > sizeof("]]") - 1) ? length - (sizeof("]]") - 1) : 0;
   }
+  ASSERT((length <= content->Facet.String.MaxLength), XML_MAX_LENGTH_ERROR,
+         "Length of xs:string content '%llu' is greater than '%u' maxLength of restriction facet.\n",
+         (unsigned long long)length, content->Facet.String.MaxLength);
+  return XML_PARSE_SUCCESS;
+}
 
-  while(1)
+/** \brief Parses the next token of XML source as per the parser state.
+ *
+ * \param parser xml_parser_t* const : XML parser.
+ * \param input const char** : input XML string to parse.
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static inline xml_parse_result_t parse_token(xml_parser_t* const parser,
+                                             const char** input, const char* const end)
+{
+  switch(parser->State)
   {
-    ASSERT_TOKEN(source, '<');
+  case EN_PARSE_CHILD:
+    return parse_parent_element(parser, input, end);
 
-    switch(*source)
-    {
-    case '?':
-      source = strstr(source, "?>");
-      ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing \"?>\".\n");
-      source += 2;
-      continue;
+  case EN_PARSE_ATTRIBUTE:
+    return parse_element(parser, input, end);
 
-    case '!':
-      source = strstr(source, "-->");
-      ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end of comment \"-->\".\n");
-      source += (sizeof("-->") - 1);
-      continue;
+  case EN_PARSE_CONTENT:
+    return parse_content(parser, input, end);
 
-    case '/':
-      for(uint32_t i = 0; i < parent->Child_Quantity; i++)
+  case EN_PARSE_END_TAG:
+    return parse_element_end(parser, input, end);
+
+  case EN_PARSE_COMMENT:
+    return skip_markup(parser, input, end, "-->", sizeof("-->") - 1);
+
+  case EN_PARSE_INSTRUCTION:
+    return skip_markup(parser, input, end, "?>", sizeof("?>") - 1);
+
+  case EN_PARSE_DOCTYPE:
+    return skip_doctype(parser, input, end);
+
+  default:
+    return XML_PARSE_SUCCESS;
+  }
+}
+
+/** \brief Parses the partial XML source (chunk) till root element is complete or end of source.
+ *  Parser parses only the complete tokens and leaves the input at incomplete token.
+ *
+ * \param parser xml_parser_t* const : XML parser.
+ * \param input const char** : input XML string to parse.
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static xml_parse_result_t parse_source(xml_parser_t* const parser,
+                                       const char** input, const char* const end)
+{
+  while(parser->State != EN_PARSE_COMPLETE)
+  {
+    if(get_token_end(parser, *input, end) == NULL)
+    {
+      if(parser->State != EN_PARSE_CONTENT)
       {
-        ASSERT(occurrence[i] >= parent->Child[i].MinOccur, XML_ELEMENT_MIN_OCCURRENCE_ERR,
-               "XML element '%s' occurred less than specified count %d in the schema\n",
-               parent->Child[i].Name.String, parent->Child[i].MinOccur);
+        const char* const source = skip_whitespace(*input, end);
+        *input = (source != NULL) ? source : end;
       }
-      *input = ++source;
-      return XML_PARSE_SUCCESS;
+      else
+      {
+        ASSERT_RESULT(validate_partial_content(parser, *input, end));
+      }
+      return XML_INCOMPLETE_SOURCE;
     }
 
-    const char* const tag = source;
-    source = get_element_end_tag(source);
-    ASSERT(source != NULL, XML_INCOMPLETE_SOURCE, "Incomplete XML source. Missing end tag (/>) of element '%s'.\n",
-           parent->Name.String);
-    size_t length = source - tag;
+    ASSERT_RESULT(parse_token(parser, input, end));
+  }
+  return XML_PARSE_SUCCESS;
+}
+
+/** \brief Parses the complete XML source till root element is complete.
+ *  Source is not resumed on a next chunk, so tokens are parsed without finding their end first,
+ *  and the start tag, content and end tag of an element are parsed in one step of the state machine.
+ *
+ * \param parser xml_parser_t* const : XML parser.
+ * \param input const char** : input XML string to parse.
+ * \param end const char* const : End of XML string.
+ * \return xml_parse_result_t : result of parsing.
+ */
+static xml_parse_result_t parse_document(xml_parser_t* const parser,
+                                         const char** input, const char* const end)
+{
+  const char* source = *input;
+  xml_parse_result_t result = XML_PARSE_SUCCESS;
+  while((parser->State != EN_PARSE_COMPLETE) && (result == XML_PARSE_SUCCESS))
+  {
+    if(parser->State != EN_PARSE_CHILD)
+    {
+      result = parse_token(parser, &source, end);
+      continue;
+    }
 
-    if(parent->Child_Order != EN_SEQUENCE)
+    result = parse_parent_element(parser, &source, end);
+    while((parser->State == EN_PARSE_ATTRIBUTE) && (result == XML_PARSE_SUCCESS))
     {
-      element_index = 0;
+      result = parse_element(parser, &source, end);
     }
-    while(1)
+    if((parser->State == EN_PARSE_CONTENT) && (result == XML_PARSE_SUCCESS))
     {
-      if((length == parent->Child[element_index].Name.Length) &&
-        (strncmp(tag, parent->Child[element_index].Name.String, length) == 0))
+      result = parse_content(parser, &source, end);
+      if(result == XML_PARSE_SUCCESS)
       {
-        break;
+        result = parse_element_end(parser, &source, end);
       }
+    }
+  }
+  *input = source;
+  return result;
+}
+
+void xml_parser_init(xml_parser_t* const parser, const xs_element_t* root,
+                     void* const target, char* buffer, size_t size
+                     CONTEXT_PTR)
+{
+  memset(&parser->Document, 0, sizeof(xs_element_t));
+  parser->Document.Child_Quantity = 1;
+  parser->Document.Child_Order    = EN_CHOICE;
+  parser->Document.Child          = root;
+  parser->State  = EN_PARSE_CHILD;
+  parser->Result = XML_INCOMPLETE_SOURCE;
+  parser->Doctype_Depth     = 0;
+  parser->Doctype_Delimiter = 0;
+
+  parser->Depth = 1;
+  parser->Level[0].Element    = &parser->Document;
+  parser->Level[0].Target     = target;
+  parser->Level[0].Occurrence = 0;
+  parser->Level[0].Index      = 0;
+  parser->Level[0].Node       = 0;
+  parser->Occurrence[0] = 0;
+
+  parser->Buffer   = buffer;
+  parser->Size     = size;
+  parser->Length   = 0;
+  parser->Position = 0;
+  parser->Event    = NULL;
+  parser->Allocator = NULL;
+#if XML_PARSER_INDEX
+  parser->Index    = NULL;
+#endif // XML_PARSER_INDEX
+#if XML_PARSER_COMPILE
+  parser->Compiled = NULL;
+#endif // XML_PARSER_COMPILE
+
+#if XML_PARSER_CONTEXT
+  parser->Context = context;
+#endif // XML_PARSER_CONTEXT
+}
+
+xml_parse_result_t xml_parse_feed(xml_parser_t* const parser, const char* chunk, size_t length)
+{
+  if(parser->Result != XML_INCOMPLETE_SOURCE)
+  {
+    return parser->Result;
+  }
+  parser->Position += length;
+
+  // Complete the incomplete token of previous chunk in the buffer.
+  while(parser->Length > 0)
+  {
+    const size_t pending = parser->Length;
+    size_t size = parser->Size - pending;
+    if(size > length)
+    {
+      size = length;
+    }
+    memcpy(&parser->Buffer[pending], chunk, size);
+
+    const char* source = parser->Buffer;
+    xml_parse_result_t result = parse_source(parser, &source, &parser->Buffer[pending + size]);
+    const size_t consumed = source - parser->Buffer;
 
-      if(parent->Child_Order == EN_SEQUENCE)
+    if(consumed >= pending)
+    {
+      // Token is complete. Resume parsing from the chunk.
+      parser->Length = 0;
+      chunk  += consumed - pending;
+      length -= consumed - pending;
+      if(result != XML_INCOMPLETE_SOURCE)
       {
-        ASSERT(occurrence[element_index] >= parent->Child[element_index].MinOccur,
-                XML_ELEMENT_MIN_OCCURRENCE_ERR,
-                "XML element '%s' occurred less than specified count %d in the schema\n",
-                parent->Child[element_index].Name.String, parent->Child[element_index].MinOccur);
+        return parser->Result = result;
       }
-      ASSERT(++element_index < parent->Child_Quantity, XML_ELEMENT_NOT_FOUND_ERR,
-             "Undefined XML element '%.*s'\n", (int)length, tag);
+      break;
+    }
+
+    if(result != XML_INCOMPLETE_SOURCE)
+    {
+      return parser->Result = result;
+    }
+    ASSERT((consumed > 0) || (size == length), parser->Result = XML_BUFFER_OVERFLOW,
+           "XML token is larger than the parser buffer.\n");
+
+    parser->Length = pending + size - consumed;
+    memmove(parser->Buffer, &parser->Buffer[consumed], parser->Length);
+    chunk  += size;
+    length -= size;
+    if(length == 0)
+    {
+      return XML_INCOMPLETE_SOURCE;
+    }
+  }
+
+  const char* source = chunk;
+  xml_parse_result_t result = parse_source(parser, &source, chunk + length);
+  if(result == XML_INCOMPLETE_SOURCE)
+  {
+    // Save the incomplete token for the next chunk.
+    const size_t pending = (chunk + length) - source;
+    ASSERT(pending <= parser->Size, parser->Result = XML_BUFFER_OVERFLOW,
+           "XML token is larger than the parser buffer.\n");
+    memcpy(parser->Buffer, source, pending);
+    parser->Length = pending;
+  }
+  return parser->Result = result;
+}
+
+xml_parse_result_t xml_parse_finish(xml_parser_t* const parser)
+{
+  return parser->Result;
+}
+
+void xml_parser_checkpoint(const xml_parser_t* const parser, xml_checkpoint_t* const checkpoint)
+{
+  checkpoint->Offset = parser->Position - parser->Length;
+  checkpoint->State  = parser->State;
+  checkpoint->Result = parser->Result;
+  checkpoint->Doctype_Depth     = parser->Doctype_Depth;
+  checkpoint->Doctype_Delimiter = parser->Doctype_Delimiter;
+  checkpoint->Depth  = parser->Depth;
+  for(uint32_t i = 0; i < parser->Depth; i++)
+  {
+    checkpoint->Index[i] = parser->Level[i].Index;
+  }
+  memcpy(checkpoint->Occurrence, parser->Occurrence, sizeof(checkpoint->Occurrence));
+}
+
+xml_parse_result_t xml_parser_restore(xml_parser_t* const parser, const xml_checkpoint_t* const checkpoint)
+{
+  ASSERT((checkpoint->Depth > 0) && (checkpoint->Depth <= XML_PARSER_MAX_DEPTH) &&
+         (checkpoint->State <= EN_PARSE_COMPLETE), XML_INVALID_CHECKPOINT, "Invalid parser checkpoint.\n");
+
+  parser->Depth = 1;
+  // Open the elements of stack again. Parent of each open element holds its index in the Index.
+  for(uint32_t i = 1; i < checkpoint->Depth; i++)
+  {
+    xml_parser_level_t* const parent = &parser->Level[i - 1];
+    const uint32_t index = checkpoint->Index[i - 1];
+    ASSERT(index < parent->Element->Child_Quantity, XML_INVALID_CHECKPOINT,
+           "Checkpoint doesn't match with child elements of '%s'.\n", parent->Element->Name.String);
+
+    const xs_element_t* const element = &parent->Element->Child[index];
+    const uint32_t occurrence = checkpoint->Occurrence[parent->Occurrence + index];
+    ASSERT((occurrence > 0) && (occurrence <= element->MaxOccur), XML_INVALID_CHECKPOINT,
+           "Checkpoint doesn't match with occurrence of '%s'.\n", element->Name.String);
+
+    parent->Index = index;
+    // Occurrences of vector are not counted again, array is grown to hold the restored occurrence.
+    void* const target = get_target_address(&element->Target, parent->Target, occurrence - 1, 0,
+                                            parser->Allocator PARSER_CONTEXT_ARG);
+    ASSERT((target != NULL) || ((element->Target.Type != EN_DYNAMIC) && (element->Target.Type != EN_VECTOR)),
+           XML_INVALID_CHECKPOINT, "Failed to allocate target of XML element '%s'.\n", element->Name.String);
+    ASSERT(open_element(parser, element, get_child_node(parser, parent, index), target) == XML_PARSE_SUCCESS, XML_INVALID_CHECKPOINT,
+           "Checkpoint doesn't fit in the parser stack.\n");
+  }
+
+  const uint32_t index = checkpoint->Index[parser->Depth - 1];
+  ASSERT((index == 0) || (index < parser->Level[parser->Depth - 1].Element->Child_Quantity),
+         XML_INVALID_CHECKPOINT, "Invalid parser checkpoint.\n");
+  parser->Level[parser->Depth - 1].Index = index;
+  memcpy(parser->Occurrence, checkpoint->Occurrence, sizeof(parser->Occurrence));
+  parser->State    = checkpoint->State;
+  parser->Result   = checkpoint->Result;
+  parser->Doctype_Depth     = checkpoint->Doctype_Depth;
+  parser->Doctype_Delimiter = checkpoint->Doctype_Delimiter;
+  parser->Length   = 0;
+  parser->Position = checkpoint->Offset;
+  return parser->Result;
+}
+
+xml_parse_result_t parse_xml_n(const xs_element_t* root, const char* source, size_t size,
+                               void* const target
+                               CONTEXT_PTR)
+{
+  xml_parser_t parser;
+  xml_parser_init(&parser, root, target, NULL, 0 CONTEXT_ARG);
+  return parse_document(&parser, &source, source + size);
+}
+
+xml_parse_result_t parse_xml(const xs_element_t* root, const char* source, void* const target
+                             CONTEXT_PTR)
+{
+  return parse_xml_n(root, source, strlen(source), target CONTEXT_ARG);
+}
+
+xml_parse_result_t parse_xml_allocator(const xs_element_t* root, const char* source, size_t size,
+                                       const xml_allocator_t* allocator, void* const target
+                                       CONTEXT_PTR)
+{
+  xml_parser_t parser;
+  xml_parser_init(&parser, root, target, NULL, 0 CONTEXT_ARG);
+  parser.Allocator = allocator;
+  return parse_document(&parser, &source, source + size);
+}
+
+xml_parse_result_t parse_xml_arena(const xs_element_t* root, const char* source, size_t size,
+                                   xml_arena_t* const arena, void* const target
+                                   CONTEXT_PTR)
+{
+  const xml_allocator_t allocator = xml_arena_allocator(arena);
+  return parse_xml_allocator(root, source, size, &allocator, target CONTEXT_ARG);
+}
+
+#if XML_PARSER_INDEX
+xml_parse_result_t xml_index_build(xml_index_t* const index, const char* source, size_t size,
+                                   uint32_t* position, size_t capacity)
+{
+  index->Source   = source;
+  index->Size     = size;
+  index->Position = position;
+  index->Count    = 0;
+  index->Next     = 0;
+  ASSERT(size <= UINT32_MAX, XML_BUFFER_OVERFLOW, "XML source is too large for structural index.\n");
+
+  const size_t count = index_class(source, source + size, &STRUCTURAL_CHAR, position, capacity);
+  ASSERT(count != SIZE_MAX, XML_BUFFER_OVERFLOW, "Structural index is larger than the position array.\n");
+  index->Count = count;
+  return XML_PARSE_SUCCESS;
+}
+
+xml_parse_result_t parse_xml_indexed(const xs_element_t* root, xml_index_t* const index,
+                                     void* const target
+                                     CONTEXT_PTR)
+{
+  xml_parser_t parser;
+  xml_parser_init(&parser, root, target, NULL, 0 CONTEXT_ARG);
+  parser.Index = index;
+  index->Next  = 0;
+
+  const char* source = index->Source;
+  return parse_document(&parser, &source, source + index->Size);
+}
+#endif // XML_PARSER_INDEX
+
+xml_parse_result_t parse_xml_next(const xs_element_t* root, const char* source, size_t size,
+                                  size_t* const offset, void* const target
+                                  CONTEXT_PTR)
+{
+  const char* const end = source + size;
+  const char* input = skip_whitespace(source + *offset, end);
+  ASSERT((input != NULL) && (skip_misc(input, end) != NULL), XML_END_OF_STREAM,
+         "No more XML document in the source.\n");
+
+  xml_parser_t parser;
+  xml_parser_init(&parser, root, target, NULL, 0 CONTEXT_ARG);
+  ASSERT_RESULT(parse_document(&parser, &input, end));
+  *offset = input - source;
+  return XML_PARSE_SUCCESS;
+}
+
+size_t xml_next_document(const char* source, size_t size, size_t offset)
+{
+  const char* const end = source + size;
+  const char* input = source + offset;
+
+  while((input = memchr(input, '<', end - input)) != NULL)
+  {
+    if(is_xml_declaration(input, end))
+    {
+      return input - source;
     }
+    input++;
+  }
+  return size;
+}
+
+#if XML_PARSER_IOV
+xml_parse_result_t parse_xml_iov(const xs_element_t* root, const struct iovec* iov, int count,
+                                 void* const target
+                                 CONTEXT_PTR)
+{
+  char buffer[XML_PARSER_IOV_BUFFER_SIZE];
+  xml_parser_t parser;
+  xml_parser_init(&parser, root, target, buffer, sizeof(buffer) CONTEXT_ARG);
+
+  for(int i = 0; (i < count) && (parser.Result == XML_INCOMPLETE_SOURCE); i++)
+  {
+    xml_parse_feed(&parser, iov[i].iov_base, iov[i].iov_len);
+  }
+  return xml_parse_finish(&parser);
+}
+#endif // XML_PARSER_IOV
+
+void xml_reader_init(xml_reader_t* const reader, const xs_element_t* root,
+                     const char* source, size_t size)
+{
+  xml_parser_init(&reader->Parser, root, NULL, NULL, 0
+                #if XML_PARSER_CONTEXT
+                  , NULL
+                #endif // XML_PARSER_CONTEXT
+                  );
+  reader->Source = source;
+  reader->End    = source + size;
+}
 
-    const xs_element_t* const element = &parent->Child[element_index];
-    void* target = get_target_address(&element->Target, parent_target,
-                                      occurrence[element_index] CONTEXT_ARG);
+xml_parse_result_t xml_reader_next(xml_reader_t* const reader, xml_event_t* const event)
+{
+  xml_parser_t* const parser = &reader->Parser;
 
-    ASSERT(++occurrence[element_index] <= element->MaxOccur, XML_ELEMENT_MAX_OCCURRENCE_ERR,
-           "XML element '%s' occurred more than specified count %d in the schema.\n",
-           element->Name.String, element->MaxOccur);
+  event->Type = EN_EVENT_NONE;
+  if(parser->Result != XML_INCOMPLETE_SOURCE)
+  {
+    return parser->Result;
+  }
 
-    if(parent->Child_Order == EN_CHOICE)
+  parser->Event = event;
+  while((event->Type == EN_EVENT_NONE) && (parser->State != EN_PARSE_COMPLETE))
+  {
+    xml_parse_result_t result = parse_token(parser, &reader->Source, reader->End);
+    if(result != XML_PARSE_SUCCESS)
     {
-      ASSERT(validate_choice_order(occurrence, parent->Child_Quantity), XML_CHOICE_ELEMENT_ERR,
-             "XML element '%s' of type choice contains more than one child element\n", parent->Name.String);
+      parser->Event = NULL;
+      return parser->Result = result;
     }
+  }
+  parser->Event = NULL;
 
-    *input = source;
-    ASSERT_RESULT(parse_element(element, input, target CONTEXT_ARG));
+  if(parser->State == EN_PARSE_COMPLETE)
+  {
+    parser->Result = XML_PARSE_SUCCESS;
+  }
+  return XML_PARSE_SUCCESS;
+}
+
+#if XML_PARSER_LOOKUP
+void xs_lookup_init(const xs_element_t* root)
+{
+  init_element_lookup(root, 1);
+}
+#endif // XML_PARSER_LOOKUP
+
+#if XML_PARSER_COMPILE
+const xs_compiled_t* xs_compile(const xs_element_t* root)
+{
+  // Collect the arrays of child elements breadth first. Node 0 is the virtual parent of root element.
+  uint32_t capacity = 16;
+  compiled_block_t* block = malloc(capacity * sizeof(compiled_block_t));
+  if(block == NULL)
+  {
+    return NULL;
+  }
+  block[0] = (compiled_block_t){.Element = root, .Quantity = 1, .Node = 1};
+  uint32_t count = 1;
+  uint32_t quantity = 2;
+  size_t table = 0;
 
-  #if XML_PARSER_CALLBACK
-    if(element->Callback)
+  for(uint32_t i = 0; i < count; i++)
+  {
+    for(uint32_t j = 0; j < block[i].Quantity; j++)
     {
-      element->Callback(occurrence[element_index], target CONTEXT_ARG);
+      const xs_element_t* const element = &block[i].Element[j];
+      table += get_compiled_table_size(element);
+      if((element->Child_Quantity == 0) || (find_compiled_block(block, count, element->Child) != NULL))
+      {
+        continue;
+      }
+
+      if(count == capacity)
+      {
+        compiled_block_t* const resized = realloc(block, 2 * capacity * sizeof(compiled_block_t));
+        if(resized == NULL)
+        {
+          free(block);
+          return NULL;
+        }
+        block = resized;
+        capacity *= 2;
+      }
+      block[count++] = (compiled_block_t){.Element = element->Child, .Quantity = element->Child_Quantity,
+                                          .Node = quantity};
+      quantity += element->Child_Quantity;
     }
-  #endif // XML_PARSER_CALLBACK
+  }
+
+  size_t size = COMPILED_ALIGN(sizeof(xs_compiled_t));
+  const size_t element_offset        = reserve_compiled_array(&size, quantity * sizeof(const xs_element_t*));
+  const size_t name_length_offset    = reserve_compiled_array(&size, quantity * sizeof(uint32_t));
+  const size_t name_prefix_offset    = reserve_compiled_array(&size, quantity * sizeof(uint64_t));
+  const size_t name_mask_offset      = reserve_compiled_array(&size, quantity * sizeof(uint64_t));
+  const size_t name_suffix_offset    = reserve_compiled_array(&size, quantity * sizeof(uint64_t));
+  const size_t child_offset          = reserve_compiled_array(&size, quantity * sizeof(uint32_t));
+  const size_t child_quantity_offset = reserve_compiled_array(&size, quantity * sizeof(uint32_t));
+  const size_t min_occur_offset      = reserve_compiled_array(&size, quantity * sizeof(uint32_t));
+  const size_t max_occur_offset      = reserve_compiled_array(&size, quantity * sizeof(uint32_t));
+  const size_t child_lookup_offset   = reserve_compiled_array(&size, quantity * sizeof(xs_lookup_t));
+  const size_t attribute_lookup_offset = reserve_compiled_array(&size, quantity * sizeof(xs_lookup_t));
+  const size_t table_offset          = reserve_compiled_array(&size, table * sizeof(uint16_t));
+
+  void* const memory = malloc(size + COMPILED_ALIGNMENT - 1);
+  if(memory == NULL)
+  {
+    free(block);
+    return NULL;
+  }
 
-    if(parent->Name.String == NULL)
+  uint8_t* const base = (uint8_t*)COMPILED_ALIGN((uintptr_t)memory);
+  xs_compiled_t* const compiled = (xs_compiled_t*)base;
+  compiled->Memory           = memory;
+  compiled->Quantity         = quantity;
+  compiled->Element          = (const xs_element_t**)(base + element_offset);
+  compiled->Name_Length      = (uint32_t*)(base + name_length_offset);
+  compiled->Name_Prefix      = (uint64_t*)(base + name_prefix_offset);
+  compiled->Name_Mask        = (uint64_t*)(base + name_mask_offset);
+  compiled->Name_Suffix      = (uint64_t*)(base + name_suffix_offset);
+  compiled->Child            = (uint32_t*)(base + child_offset);
+  compiled->Child_Quantity   = (uint32_t*)(base + child_quantity_offset);
+  compiled->Min_Occur        = (uint32_t*)(base + min_occur_offset);
+  compiled->Max_Occur        = (uint32_t*)(base + max_occur_offset);
+  compiled->Child_Lookup     = (xs_lookup_t*)(base + child_lookup_offset);
+  compiled->Attribute_Lookup = (xs_lookup_t*)(base + attribute_lookup_offset);
+
+  // Virtual parent of root element has no name and lookup.
+  static const xs_element_t DOCUMENT = {.Name.String = "", .Child_Quantity = 1, .Child_Order = EN_SEQUENCE};
+  uint16_t* lookup = compile_node(compiled, 0, &DOCUMENT, 1, (uint16_t*)(base + table_offset));
+  compiled->Element[0] = NULL;
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    for(uint32_t j = 0; j < block[i].Quantity; j++)
     {
-      return XML_PARSE_SUCCESS;
+      const xs_element_t* const element = &block[i].Element[j];
+      const compiled_block_t* const child = find_compiled_block(block, count, element->Child);
+      lookup = compile_node(compiled, block[i].Node + j, element,
+                            ((element->Child_Quantity != 0) && (child != NULL)) ? child->Node : 0, lookup);
     }
-    source = *input;
   }
+
+  free(block);
+  return compiled;
 }
 
-xml_parse_result_t parse_xml(const xs_element_t* root, const char* source, void* const target
-                             CONTEXT_PTR)
+void xs_compiled_free(const xs_compiled_t* compiled)
 {
-  const xs_element_t parent =
+  if(compiled != NULL)
   {
-      .Child_Quantity = 1,
-      .Child_Order    = EN_CHOICE,
-      .Child          = root,
-  };
-  return parse_parent_element(&parent, &source, target CONTEXT_ARG);
+    free(compiled->Memory);
+  }
+}
+
+xml_parse_result_t parse_xml_compiled(const xs_compiled_t* compiled, const char* source, size_t size,
+                                      void* const target
+                                      CONTEXT_PTR)
+{
+  xml_parser_t parser;
+  xml_parser_init(&parser, compiled->Element[1], target, NULL, 0 CONTEXT_ARG);
+  parser.Compiled = compiled;
+  return parse_document(&parser, &source, source + size);
+}
+#endif // XML_PARSER_COMPILE
+
+const char* xml_parser_init_cpu(void)
+{
+#if XML_SCAN_DISPATCH
+  const scan_kernel_t* const kernel = scan_select_kernel();
+  __atomic_store_n(&xml_scan_kernel, kernel, __ATOMIC_RELEASE);
+  return kernel->Name;
+#else
+  return SCAN_KERNEL_NAME;
+#endif // XML_SCAN_DISPATCH
 }
@@ -34,6 +34,73 @@
   #define XML_PARSER_DEBUG 0
 #endif // XML_PARSER_DEBUG
 
+//! By default parsing of scatter-gather (iovec) XML source is disabled.
+#ifndef XML_PARSER_IOV
+  #define XML_PARSER_IOV 0
+#endif // XML_PARSER_IOV
+
+//! Size of buffer to join the token of XML source split across two iovec buffers.
+#ifndef XML_PARSER_IOV_BUFFER_SIZE
+  #define XML_PARSER_IOV_BUFFER_SIZE 1024
+#endif // XML_PARSER_IOV_BUFFER_SIZE
+
+//! By default parser uses SIMD (SSE2/AVX2 as enabled by compiler) or SWAR scanning kernels.
+//! Set it to 0 to use only the portable byte by byte scanning.
+#ifndef XML_PARSER_SIMD
+  #define XML_PARSER_SIMD 1
+#endif // XML_PARSER_SIMD
+
+//! By default on x86-64 (GCC/Clang) SIMD kernels are selected at run time from the features of CPU,
+//! so that one binary uses AVX2 where available and still runs on older CPUs.
+//! Set it to 0 to select the kernels only from the compiler flags (e.g. -mavx2).
+#ifndef XML_PARSER_CPU_DISPATCH
+  #define XML_PARSER_CPU_DISPATCH 1
+#endif // XML_PARSER_CPU_DISPATCH
+
+//! Number of occurrences allocated on the first occurrence of an element of EN_VECTOR address type.
+#ifndef XML_PARSER_VECTOR_CAPACITY
+  #define XML_PARSER_VECTOR_CAPACITY 4
+#endif // XML_PARSER_VECTOR_CAPACITY
+
+//! By default structural index (two stage parsing) is disabled.
+#ifndef XML_PARSER_INDEX
+  #define XML_PARSER_INDEX 0
+#endif // XML_PARSER_INDEX
+
+//! By default elements can have perfect hash lookup of names of child elements and attributes (xs_lookup_t).
+//! Set it to 0 to always match the names linearly and save two pointers per element.
+#ifndef XML_PARSER_LOOKUP
+  #define XML_PARSER_LOOKUP 1
+#endif // XML_PARSER_LOOKUP
+
+//! By default schema can be compiled by \ref xs_compile to a contiguous table of its hot fields for \ref parse_xml_compiled.
+//! It allocates the compiled schema using malloc and requires XML_PARSER_LOOKUP. Set it to 0 if not required.
+#ifndef XML_PARSER_COMPILE
+  #define XML_PARSER_COMPILE XML_PARSER_LOOKUP
+#endif // XML_PARSER_COMPILE
+
+#if XML_PARSER_COMPILE && !XML_PARSER_LOOKUP
+  #error "XML_PARSER_COMPILE requires XML_PARSER_LOOKUP."
+#endif
+
+//! Maximum nesting depth of XML elements (including root element) supported by the parser.
+//! Parser holds the open elements in \ref xml_parser_t instead of call stack, hence the depth is limited:
+//! parsing XML nested deeper fails with XML_PARSER_STACK_OVERFLOW. Each level takes 32 bytes of \ref xml_parser_t on 64-bit targets.
+#ifndef XML_PARSER_MAX_DEPTH
+  #define XML_PARSER_MAX_DEPTH 16
+#endif // XML_PARSER_MAX_DEPTH
+
+//! Total number of child elements and attribute words of all the open (nested) XML elements supported by the parser.
+//! Parsing XML whose open elements need more fails with XML_PARSER_STACK_OVERFLOW.
+//! Each takes 4 bytes of \ref xml_parser_t and \ref xml_checkpoint_t.
+#ifndef XML_PARSER_MAX_OCCURRENCE
+  #define XML_PARSER_MAX_OCCURRENCE 256
+#endif // XML_PARSER_MAX_OCCURRENCE
+
+#if (XML_PARSER_MAX_DEPTH < 2) || (XML_PARSER_MAX_OCCURRENCE < 1)
+  #error "XML_PARSER_MAX_DEPTH must hold the root element and XML_PARSER_MAX_OCCURRENCE its parent."
+#endif
+
 //! List of result code of \ref parse_xml
 #define XML_PARSER_RESULT \
   ADD_RESULT_CODE(XML_PARSE_SUCCESS,                Successfully parsed XML.)  \
@@ -56,7 +123,13 @@
   ADD_RESULT_CODE(XML_ENUM_NOT_FOUND,               Content does not match with any of specified enumerations.)  \
   ADD_RESULT_CODE(XML_DURATION_SYNTAX_ERROR,        XML syntax error in duration content.)  \
   ADD_RESULT_CODE(XML_DATE_TIME_SYNTAX_ERROR,       XML syntax error in date time content.)  \
-  ADD_RESULT_CODE(FAILED_TO_ALLOCATE_MEMORY,        Failed to allocate the memory of string dynamic type.)
+  ADD_RESULT_CODE(FAILED_TO_ALLOCATE_MEMORY,        Failed to allocate the memory of string dynamic type and of dynamic or vector target.) \
+  ADD_RESULT_CODE(XML_PARSER_STACK_OVERFLOW,        XML element tree is deeper than parser stack.) \
+  ADD_RESULT_CODE(XML_BUFFER_OVERFLOW,              XML token is larger than the parser buffer.) \
+  ADD_RESULT_CODE(XML_FILE_ERROR,                   Failed to open or map the XML file.) \
+  ADD_RESULT_CODE(XML_DECOMPRESS_ERROR,             Failed to read or decompress the XML stream.) \
+  ADD_RESULT_CODE(XML_END_OF_STREAM,                No more XML document in the source.) \
+  ADD_RESULT_CODE(XML_INVALID_CHECKPOINT,           Checkpoint does not match with the schema or parser configuration.)
 
 /*
  *  ------------------------------- ENUMERATION -------------------------------
@@ -76,6 +149,8 @@ typedef enum
   EN_STATIC,      //!< Target address is static. No dynamic allocation is required.
   EN_DYNAMIC,     //!< call Allocate() callback to get target address.
   EN_RELATIVE,    //!< Target address is relative to its immediate parent target address
+  EN_RECORD,      //!< Target address is static and reused for every occurrence. It is cleared before each occurrence.
+  EN_VECTOR,      //!< Occurrences are stored in a growable array (xml_vector_t) relative to its immediate parent target address.
   TOTAL_TARGET_ADDRESS_TYPE
 }address_type_t;
 
@@ -95,6 +170,39 @@ typedef enum
   EN_SEQUENCE,
 }child_order_type_t;
 
+//! List of parser states. It specifies the next expected token in the XML source.
+typedef enum
+{
+  EN_PARSE_CHILD,       //!< Child element, comment or end tag of an open element
+  EN_PARSE_ATTRIBUTE,   //!< Attribute or end of start tag of an open element
+  EN_PARSE_CONTENT,     //!< Content of an open element
+  EN_PARSE_END_TAG,     //!< End tag of an open element
+  EN_PARSE_COMMENT,     //!< Rest of comment, followed by child element of an open element
+  EN_PARSE_INSTRUCTION, //!< Rest of processing instruction, followed by child element of an open element
+  EN_PARSE_DOCTYPE,     //!< Rest of DOCTYPE declaration, followed by root element
+  EN_PARSE_COMPLETE,    //!< Parsing of root element is complete
+}xml_parser_state_t;
+
+//! List of events reported by XML reader
+typedef enum
+{
+  EN_EVENT_NONE,        //!< No more events. Parsing of root element is complete.
+  EN_EVENT_START,       //!< Start tag of an element
+  EN_EVENT_ATTRIBUTE,   //!< Attribute of an element
+  EN_EVENT_CONTENT,     //!< Content of an element
+  EN_EVENT_END,         //!< End of an element
+}xml_event_type_t;
+
+//! Properties of raw text (content or attribute value) found while scanning it.
+//! Text without any of these needs no entity decoding, newline normalization or UTF-8 validation.
+typedef enum
+{
+  EN_TEXT_ENTITY          = 0x01,   //!< Text contains '&' (entity or character reference)
+  EN_TEXT_CARRIAGE_RETURN = 0x02,   //!< Text contains '\r'
+  EN_TEXT_NON_ASCII       = 0x04,   //!< Text contains bytes above 0x7F
+  EN_TEXT_CDATA           = 0x08,   //!< Text is the body of CDATA section. It has no entity references.
+}xml_text_property_t;
+
 //! List of enumeration for attribute **use**
 typedef enum
 {
@@ -110,6 +218,10 @@ typedef enum
 
 #include "xml_content.h"
 
+#if XML_PARSER_IOV
+#include <sys/uio.h>
+#endif // XML_PARSER_IOV
+
 /*
  *  -------------------------------- STRUCTURE --------------------------------
  */
@@ -147,6 +259,18 @@ typedef struct
   typedef void* (*allocate)(uint32_t occurrence);
 #endif // XML_PARSER_CONTEXT
 
+/** A function pointer to allocate dynamic memory to store all the occurrences of element at once.
+ *
+ * \param count uint32_t    : Number of occurrences of the element under its parent element
+ * \param context void*     : Context passed to xml parser.
+ * \return void*             : Address of array of count occurrences
+ */
+#if XML_PARSER_CONTEXT
+  typedef void* (*allocate_n)(uint32_t count, void* context);
+#else
+  typedef void* (*allocate_n)(uint32_t count);
+#endif // XML_PARSER_CONTEXT
+
 //! Structure to holds/allocate the target address to store XML content
 typedef struct
 {
@@ -155,23 +279,49 @@ typedef struct
   //! Use of fields of below union depends on selected address type
   union  {
 
-    //! Address of target to store XML content. Applicable if address type is static.
+    //! Address of target to store XML content. Applicable if address type is static or record.
     void* Address;
 
     //! callback function to allocate memory to store XML content.
-    //! Applicable if address type is dynamic
+    //! Applicable if address type is dynamic. If it is NULL, parser allocates the target of Size bytes
+    //! (cleared to zero) from the allocator of parser.
     allocate Allocate;
 
-    //! Offset from parent target address.
-    //! e.g. target address = parent target address + offset.
-    //! Applicable if address type is relative
-    size_t Offset;
+    //! Applicable if address type is relative or vector.
+    struct {
+      //! Offset from parent target address.
+      //! e.g. target address = parent target address + offset.
+      //! In case of vector address type, offset of xml_vector_t.
+      size_t Offset;
+
+      //! callback function to allocate the array of all the occurrences at once. Applicable if address type is vector.
+      //! Parser counts the occurrences by a structural pre-pass of parent element on the first occurrence.
+      //! If it is NULL, or the end tag of parent is not yet in the source fed in chunks,
+      //! parser grows the array from the allocator of parser.
+      allocate_n AllocateN;
+    };
   };
 
   //! Size of Target in case of multiple occurrences to calculate the next target address.
+  //! In case of record address type, size of target to clear before each occurrence.
+  //! In case of vector address type, size of each occurrence in the array.
   uint32_t Size;
 }target_address_t;
 
+//! Growable array of occurrences of an element of EN_VECTOR address type.
+//! Parser clears it on the first occurrence and grows the array geometrically from the allocator of parser.
+//! Growing may move the array, hence address of an occurrence is valid only till the next occurrence.
+//! With AllocateN callback, array is allocated once and never moves, if the occurrences are counted.
+typedef struct
+{
+  //! Array of occurrences, each of Target.Size bytes. Free it as allocated by AllocateN callback if Counted,
+  //! else using the allocator of parser.
+  void* Data;
+  uint32_t Count;       //!< Number of occurrences
+  uint32_t Capacity;    //!< Number of occurrences the array can hold
+  bool Counted;         //!< true if Data is allocated by AllocateN callback for the counted occurrences
+}xml_vector_t;
+
 //! structure to define the attribute to an element
 typedef struct
 {
@@ -203,8 +353,152 @@ struct xs_element_t
   uint32_t Child_Quantity;          //!< Number of child elements of an element
   child_order_type_t Child_Order;   //!< order type of child elements
   const xs_element_t* Child;        //!< Address to array of child elements
+
+#if XML_PARSER_LOOKUP
+  xs_lookup_t* Child_Lookup;        //!< Perfect hash of names of child elements. NULL to match them linearly.
+  xs_lookup_t* Attribute_Lookup;    //!< Perfect hash of names of attributes. NULL to match them linearly.
+#endif // XML_PARSER_LOOKUP
 };
 
+#if XML_PARSER_COMPILE
+//! Immutable schema compiled by \ref xs_compile. Every element of XML element tree is a node.
+//! Hot fields of nodes used to match the child elements and attributes are stored in separate (SoA) arrays,
+//! each aligned to cache line in one allocation. Child elements of a node are consecutive nodes.
+//! Node 0 is the virtual parent of root element (node 1).
+typedef struct
+{
+  void* Memory;                     //!< Allocation holding the compiled schema
+  uint32_t Quantity;                //!< Number of nodes
+  const xs_element_t** Element;     //!< Schema element of each node for the rest of its fields
+  uint32_t* Name_Length;            //!< Length of name of each node
+  uint64_t* Name_Prefix;            //!< First 8 bytes of name of each node, zero padded
+  uint64_t* Name_Mask;              //!< Mask of bytes of Name_Prefix that belong to the name
+  uint64_t* Name_Suffix;            //!< Last 8 bytes of name of each node longer than 8 bytes
+  uint32_t* Child;                  //!< First child node of each node
+  uint32_t* Child_Quantity;         //!< Number of child nodes of each node
+  uint32_t* Min_Occur;              //!< Minimum occurrence of each node
+  uint32_t* Max_Occur;              //!< Maximum occurrence of each node
+  xs_lookup_t* Child_Lookup;        //!< Lookup of child elements of each node. Empty for sequence order.
+  xs_lookup_t* Attribute_Lookup;    //!< Lookup of attributes of each node. Empty for up to 16 attributes.
+}xs_compiled_t;
+#endif // XML_PARSER_COMPILE
+
+//! Holds the XML content extracted by XML reader. Use of field depends on the content type.
+//! String content (EN_STRING, EN_STRING_DYNAMIC and EN_CHAR_ARRAY) is not copied and
+//! points into the XML source. Content of EN_NO_XML_DATA_TYPE is reported as string.
+typedef union
+{
+  string_t String;            //!< String content
+  uint32_t Uint;              //!< EN_UINT32, EN_ENUM_UINT and index of EN_ENUM_STRING
+  int32_t Int;                //!< EN_INT32 content
+  uint16_t Uint16;            //!< EN_UINT16 content
+  uint8_t Uint8;              //!< EN_UINT8 content
+  float Decimal;              //!< EN_DECIMAL content
+  xs_date_t Date;             //!< EN_DATE content
+  xs_time_t Time;             //!< EN_TIME content
+  xs_date_time_t Date_Time;   //!< EN_DATE_TIME content
+  xs_duration_t Duration;     //!< EN_DURATION content
+}xml_value_t;
+
+//! Event reported by XML reader
+typedef struct
+{
+  xml_event_type_t Type;            //!< Type of event
+  const xs_element_t* Element;      //!< Schema of an element of event
+  const xs_attribute_t* Attribute;  //!< Schema of an attribute. Applicable to attribute event.
+  uint32_t Occurrence;              //!< Occurrence of an element. Applicable to start and end event.
+  xml_value_t Value;                //!< Extracted content. Applicable to attribute and content event.
+  uint32_t Text;                    //!< Properties (xml_text_property_t) of raw text. Applicable to attribute and content event.
+}xml_event_t;
+
+#if XML_PARSER_INDEX
+//! Structural index of XML source built by stage 1 of two stage parsing.
+typedef struct
+{
+  const char* Source;     //!< XML source
+  size_t Size;            //!< Size of XML source
+  uint32_t* Position;     //!< Offsets of structural chars ('<', '>', '/', '=', '"', '?', '!') in ascending order
+  size_t Count;           //!< Number of offsets
+  size_t Next;            //!< Index of first offset not yet passed by the parser
+}xml_index_t;
+#endif // XML_PARSER_INDEX
+
+//! Parsing state of an open XML element
+typedef struct
+{
+  const xs_element_t* Element;  //!< Schema of an open element
+  void* Target;                 //!< Target address of an open element
+  uint32_t Occurrence;          //!< Index of occurrence table of child elements (followed by attributes) in the parser
+  uint32_t Index;               //!< Index of last parsed child element
+  uint32_t Node;                //!< Node of an open element in the compiled schema. 0 if not used.
+}xml_parser_level_t;
+
+//! Structure to hold the parsing state of XML source fed in multiple chunks.
+//! Parser doesn't hold any reference to the chunk after \ref xml_parse_feed returns.
+typedef struct
+{
+  xs_element_t Document;            //!< Virtual parent element of root element
+  xml_parser_state_t State;         //!< Next expected token in the XML source
+  xml_parse_result_t Result;        //!< Result of parsing so far
+  uint32_t Doctype_Depth;           //!< Nesting depth of brackets of DOCTYPE declaration being skipped
+  uint32_t Doctype_Delimiter;       //!< Open literal ('"' or '\'') or comment ('-') of DOCTYPE declaration being skipped
+
+  uint32_t Depth;                                       //!< Number of open elements
+  xml_parser_level_t Level[XML_PARSER_MAX_DEPTH];       //!< Stack of open elements
+  uint32_t Occurrence[XML_PARSER_MAX_OCCURRENCE];       //!< Occurrence tables of child elements of open elements
+
+  char* Buffer;     //!< Buffer to hold incomplete token at the end of chunk
+  size_t Size;      //!< Size of buffer
+  size_t Length;    //!< Length of incomplete token in the buffer
+  uint64_t Position;  //!< Number of bytes of XML source fed to the parser
+
+  //! Event of XML reader. Parser extracts the content to the event instead of target address.
+  //! NULL if not used by XML reader.
+  xml_event_t* Event;
+
+  //! Allocator of content of EN_STRING_DYNAMIC type, array of EN_VECTOR type and target of EN_DYNAMIC type
+  //! without Allocate (or AllocateN) callback.
+  //! NULL to allocate them using malloc. Set it after \ref xml_parser_init.
+  const xml_allocator_t* Allocator;
+
+#if XML_PARSER_INDEX
+  xml_index_t* Index;   //!< Structural index of XML source. NULL if not used.
+#endif // XML_PARSER_INDEX
+
+#if XML_PARSER_COMPILE
+  //! Compiled schema of root element. NULL if not used.
+  //! Set it after \ref xml_parser_init to parse the chunks using the compiled schema.
+  const xs_compiled_t* Compiled;
+#endif // XML_PARSER_COMPILE
+
+#if XML_PARSER_CONTEXT
+  void* Context;    //!< User defined context
+#endif // XML_PARSER_CONTEXT
+}xml_parser_t;
+
+//! Serializable snapshot of the parsing state of XML source fed in chunks.
+//! It contains only integers (schema elements are stored as indices of child elements), hence it can be
+//! written to a file as is and restored in another process using the same schema and parser configuration.
+typedef struct
+{
+  uint64_t Offset;      //!< Offset of XML source from where to resume feeding the parser
+  uint32_t State;       //!< Next expected token in the XML source (xml_parser_state_t)
+  uint32_t Result;      //!< Result of parsing so far (xml_parse_result_t)
+  uint32_t Doctype_Depth;       //!< Nesting depth of brackets of DOCTYPE declaration being skipped
+  uint32_t Doctype_Delimiter;   //!< Open literal or comment of DOCTYPE declaration being skipped
+  uint32_t Depth;       //!< Number of open elements
+  uint32_t Index[XML_PARSER_MAX_DEPTH];             //!< Index of last parsed child element of each open element
+  uint32_t Occurrence[XML_PARSER_MAX_OCCURRENCE];   //!< Occurrence tables of child elements and attributes of open elements
+}xml_checkpoint_t;
+
+//! Structure to hold the state of XML reader
+typedef struct
+{
+  xml_parser_t Parser;    //!< Parsing state of XML source
+  const char* Source;     //!< Current position in the XML source
+  const char* End;        //!< End of XML source
+}xml_reader_t;
+
 /*
  *  ---------------------------- EXPORTED FUNCTION ----------------------------
  */
@@ -227,5 +521,304 @@ extern xml_parse_result_t parse_xml(const xs_element_t* root, const char* source
                                      , void* context
                                    #endif // XML_PARSER_CONTEXT
                                    );
+
+/** \brief XML parser to parse XML source of specified size. Source need not be NULL terminated.
+ * Parser never reads beyond the end of source, hence it can parse read-only memory mapped files
+ * or part of a larger buffer without copying it.
+ *
+ * \param root const xs_element_t*: Pointer to root element of XML element tree.
+ * \param source const char*      : Buffer containing XML source to parse.
+ * \param size size_t             : Size of XML source.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing.
+ *
+ */
+extern xml_parse_result_t parse_xml_n(const xs_element_t* root, const char* source, size_t size,
+                                      void* const target
+                                     #if XML_PARSER_CONTEXT
+                                       , void* context
+                                     #endif // XML_PARSER_CONTEXT
+                                     );
+
+/** \brief XML parser to parse XML source of specified size, allocating the memory from the given allocator
+ * instead of malloc: content of EN_STRING_DYNAMIC type and target of EN_DYNAMIC type without Allocate callback.
+ *
+ * \param root const xs_element_t*: Pointer to root element of XML element tree.
+ * \param source const char*      : Buffer containing XML source to parse.
+ * \param size size_t             : Size of XML source.
+ * \param allocator const xml_allocator_t* : Allocator of the parse. NULL to use malloc.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing. FAILED_TO_ALLOCATE_MEMORY if allocator fails.
+ *
+ */
+extern xml_parse_result_t parse_xml_allocator(const xs_element_t* root, const char* source, size_t size,
+                                              const xml_allocator_t* allocator, void* const target
+                                             #if XML_PARSER_CONTEXT
+                                               , void* context
+                                             #endif // XML_PARSER_CONTEXT
+                                             );
+
+/** \brief XML parser to parse XML source of specified size, allocating the content of EN_STRING_DYNAMIC type
+ * (and target of EN_DYNAMIC type without Allocate callback) from the arena instead of malloc. Release all the strings at once using \ref xml_arena_reset.
+ *
+ * \param root const xs_element_t*: Pointer to root element of XML element tree.
+ * \param source const char*      : Buffer containing XML source to parse.
+ * \param size size_t             : Size of XML source.
+ * \param arena xml_arena_t* const : Arena initialized by \ref xml_arena_init.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing. FAILED_TO_ALLOCATE_MEMORY if failed to allocate the block of arena.
+ *
+ */
+extern xml_parse_result_t parse_xml_arena(const xs_element_t* root, const char* source, size_t size,
+                                          xml_arena_t* const arena, void* const target
+                                         #if XML_PARSER_CONTEXT
+                                           , void* context
+                                         #endif // XML_PARSER_CONTEXT
+                                         );
+
+#if XML_PARSER_INDEX
+/** \brief Builds the structural index of XML source (stage 1 of two stage parsing).
+ * It stores the offsets of all the structural chars ('<', '>', '/', '=', '"', '?', '!') of the source
+ * using SIMD, so that \ref parse_xml_indexed jumps to the end of content and attribute values
+ * instead of scanning them byte by byte. Scan for the end of element and attribute names is bounded
+ * by the next structural char.
+ *
+ * \param index xml_index_t* const : Structural index to build.
+ * \param source const char*       : Buffer containing XML source. It need not be NULL terminated.
+ * \param size size_t              : Size of XML source. It must be less than 4 GiB.
+ * \param position uint32_t*       : Array to store the offsets. It needs one entry per structural char
+ *                                   (at most size entries).
+ * \param capacity size_t          : Number of entries in the position array.
+ * \return xml_parse_result_t XML_BUFFER_OVERFLOW if source is too large or array is too small.
+ *
+ */
+extern xml_parse_result_t xml_index_build(xml_index_t* const index, const char* source, size_t size,
+                                          uint32_t* position, size_t capacity);
+
+/** \brief XML parser to parse XML source using its structural index (stage 2 of two stage parsing).
+ *
+ * \param root const xs_element_t*: Pointer to root element of XML element tree.
+ * \param index xml_index_t* const : Structural index built by \ref xml_index_build.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing.
+ *
+ */
+extern xml_parse_result_t parse_xml_indexed(const xs_element_t* root, xml_index_t* const index,
+                                            void* const target
+                                           #if XML_PARSER_CONTEXT
+                                             , void* context
+                                           #endif // XML_PARSER_CONTEXT
+                                           );
+#endif // XML_PARSER_INDEX
+
+/** \brief Parses the next XML document from a source of concatenated XML documents.
+ * Each document is parsed as by \ref parse_xml_n. Whitespace before the document is skipped.
+ * On success, offset is set to the end of document (just after the end tag of root element),
+ * so that next call parses the next document.
+ *
+ * \param root const xs_element_t*: Pointer to root element of XML element tree.
+ * \param source const char*      : Buffer containing concatenated XML documents.
+ * \param size size_t             : Size of XML source.
+ * \param offset size_t* const    : Offset of the document to parse in the source. Updated to end of document on success.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing. XML_END_OF_STREAM if there is no document after offset,
+ *         i.e. only whitespace, comments and processing instructions (other than XML declaration) are left.
+ *
+ */
+extern xml_parse_result_t parse_xml_next(const xs_element_t* root, const char* source, size_t size,
+                                         size_t* const offset, void* const target
+                                        #if XML_PARSER_CONTEXT
+                                          , void* context
+                                        #endif // XML_PARSER_CONTEXT
+                                        );
+
+/** \brief Finds the start of next XML document (its "<?xml" declaration) in a source of concatenated XML documents,
+ * without parsing the source in between. It is used to split the source into documents
+ * that can be parsed independently (e.g. on multiple threads) or to resynchronize after an invalid document.
+ * Declaration inside a comment or CDATA section of a document is also treated as a start of document.
+ *
+ * \param source const char* : Buffer containing concatenated XML documents.
+ * \param size size_t        : Size of XML source.
+ * \param offset size_t      : Offset from where to search the next document.
+ * \return size_t : Offset of next XML declaration at or after offset. Size if not found.
+ *
+ */
+extern size_t xml_next_document(const char* source, size_t size, size_t offset);
+
+#if XML_PARSER_IOV
+/** \brief XML parser to parse XML source scattered in multiple buffers, without copying them into one buffer.
+ * Only a token split across two buffers is joined in a buffer of size XML_PARSER_IOV_BUFFER_SIZE on the stack.
+ * Content of EN_STRING type of such a token is valid only in the element callback.
+ *
+ * \param root const xs_element_t*: Pointer to root element of XML element tree.
+ * \param iov const struct iovec* : Array of buffers containing XML source.
+ * \param count int               : Number of buffers.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing.
+ *
+ */
+extern xml_parse_result_t parse_xml_iov(const xs_element_t* root, const struct iovec* iov, int count,
+                                        void* const target
+                                       #if XML_PARSER_CONTEXT
+                                         , void* context
+                                       #endif // XML_PARSER_CONTEXT
+                                       );
+#endif // XML_PARSER_IOV
+
+/** \brief Initialize the parser to parse XML source fed in multiple chunks.
+ *
+ * \param parser xml_parser_t* const : Parser to initialize.
+ * \param root const xs_element_t*   : Pointer to root element of XML element tree.
+ * \param target void* const         : Target address to store content of XML element in case of relative addressing type.
+ * \param buffer char*               : Buffer to hold an incomplete token (tag, attributes or content)
+ *        at the end of a chunk till the next chunk arrives. It must be large enough to hold the largest tag
+ *        and the string content up to its maxLength. Comments, processing instructions and DOCTYPE declaration
+ *        are skipped incrementally, hence they need not fit in the buffer.
+ * \param size size_t                : Size of buffer.
+ * \param context void*              : User defined context. Passed to all the callback functions.
+ *
+ */
+extern void xml_parser_init(xml_parser_t* const parser, const xs_element_t* root,
+                            void* const target, char* buffer, size_t size
+                           #if XML_PARSER_CONTEXT
+                             , void* context
+                           #endif // XML_PARSER_CONTEXT
+                           );
+
+/** \brief Parses next chunk of XML source. Parser resumes from where the previous chunk ended.
+ * Content of EN_STRING type points into the chunk (or the parser buffer) and is valid only till
+ * the chunk is released by the caller. Use element callback to consume it.
+ *
+ * \param parser xml_parser_t* const : Parser initialized by \ref xml_parser_init.
+ * \param chunk const char*          : Next chunk of XML source. It need not be NULL terminated.
+ * \param length size_t              : Length of chunk.
+ * \return xml_parse_result_t XML_INCOMPLETE_SOURCE if parser expects more chunks,
+ *         XML_PARSE_SUCCESS on completion of root element, otherwise error.
+ *
+ */
+extern xml_parse_result_t xml_parse_feed(xml_parser_t* const parser, const char* chunk, size_t length);
+
+/** \brief Completes the parsing of XML source fed in chunks.
+ *
+ * \param parser xml_parser_t* const : Parser initialized by \ref xml_parser_init.
+ * \return xml_parse_result_t result of XML parsing. XML_INCOMPLETE_SOURCE if root element is not complete.
+ *
+ */
+extern xml_parse_result_t xml_parse_finish(xml_parser_t* const parser);
+
+/** \brief Takes a snapshot of the parsing state of XML source fed in chunks.
+ * An incomplete token held in the parser buffer is not part of the checkpoint.
+ * Instead, checkpoint offset points to its start, so it is fed again after restore.
+ *
+ * \param parser const xml_parser_t* const : Parser initialized by \ref xml_parser_init.
+ * \param checkpoint xml_checkpoint_t* const : Snapshot of the parsing state.
+ *
+ */
+extern void xml_parser_checkpoint(const xml_parser_t* const parser, xml_checkpoint_t* const checkpoint);
+
+/** \brief Restores the parsing state from the checkpoint. Resume feeding the XML source from checkpoint offset.
+ * Target addresses of open elements are derived again as on their start tags: target of EN_DYNAMIC type is
+ * allocated again, and array of EN_VECTOR type is allocated again (or grown, if restored occurrence is not the first)
+ * from the allocator of parser to hold the restored occurrence, clearing the occurrences it doesn't hold yet.
+ * Occurrences are not counted again, hence AllocateN callback is not called on restore.
+ * Content stored to the target before the checkpoint is not part of the checkpoint.
+ *
+ * \param parser xml_parser_t* const : Parser initialized by \ref xml_parser_init with the same schema.
+ * \param checkpoint const xml_checkpoint_t* const : Snapshot taken by \ref xml_parser_checkpoint.
+ * \return xml_parse_result_t XML_INVALID_CHECKPOINT if checkpoint doesn't match the schema or
+ *         target of an open element of EN_DYNAMIC or EN_VECTOR type can't be allocated,
+ *         otherwise result of parsing at the checkpoint.
+ *
+ */
+extern xml_parse_result_t xml_parser_restore(xml_parser_t* const parser, const xml_checkpoint_t* const checkpoint);
+
+/** \brief Initialize the XML reader to pull the events of XML source one by one.
+ * Reader validates the XML source against the schema but doesn't store the content to target address
+ * and doesn't trigger any callback.
+ *
+ * \param reader xml_reader_t* const : XML reader to initialize.
+ * \param root const xs_element_t*   : Pointer to root element of XML element tree.
+ * \param source const char*         : Buffer containing XML source. It need not be NULL terminated.
+ * \param size size_t                : Size of XML source.
+ *
+ */
+extern void xml_reader_init(xml_reader_t* const reader, const xs_element_t* root,
+                            const char* source, size_t size);
+
+/** \brief Parses the XML source till next event.
+ *
+ * \param reader xml_reader_t* const : XML reader initialized by \ref xml_reader_init.
+ * \param event xml_event_t* const   : Next event (start, attribute, content or end) with its schema and
+ *        extracted content. EN_EVENT_NONE on completion of root element.
+ * \return xml_parse_result_t XML_PARSE_SUCCESS on success otherwise error.
+ *
+ */
+extern xml_parse_result_t xml_reader_next(xml_reader_t* const reader, xml_event_t* const event);
+
+#if XML_PARSER_LOOKUP
+/** \brief Builds the perfect hash lookup of all the elements of XML element tree that provide it.
+ * Call it once before parsing with the schema. Lookup of an element whose names can't be hashed perfectly
+ * (names of same length differing only in the middle) is left empty and its names are matched linearly.
+ *
+ * \param root const xs_element_t* : Pointer to root element of XML element tree.
+ *
+ */
+extern void xs_lookup_init(const xs_element_t* root);
+#endif // XML_PARSER_LOOKUP
+
+#if XML_PARSER_COMPILE
+/** \brief Compiles the XML element tree to an immutable table of its nodes (\ref xs_compiled_t)
+ * with the perfect hash lookup of child elements of random and choice order and of more than 16 attributes of every element.
+ * Element reached again through a recursive schema is compiled once. Schema must not change till the
+ * compiled schema is freed. Compiled schema is read only, hence it can be shared by the parsing threads.
+ *
+ * \param root const xs_element_t* : Pointer to root element of XML element tree.
+ * \return const xs_compiled_t* : Compiled schema. NULL if failed to allocate the memory.
+ *
+ */
+extern const xs_compiled_t* xs_compile(const xs_element_t* root);
+
+/** \brief Frees the schema compiled by \ref xs_compile.
+ *
+ * \param compiled const xs_compiled_t* : Compiled schema. NULL is ignored.
+ *
+ */
+extern void xs_compiled_free(const xs_compiled_t* compiled);
+
+/** \brief XML parser to parse XML source of specified size using the compiled schema.
+ * It is same as \ref parse_xml_n, except that names are matched using the compiled schema.
+ *
+ * \param compiled const xs_compiled_t* : Schema compiled by \ref xs_compile.
+ * \param source const char*      : Buffer containing XML source to parse.
+ * \param size size_t             : Size of XML source.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing.
+ *
+ */
+extern xml_parse_result_t parse_xml_compiled(const xs_compiled_t* compiled, const char* source, size_t size,
+                                             void* const target
+                                            #if XML_PARSER_CONTEXT
+                                              , void* context
+                                            #endif // XML_PARSER_CONTEXT
+                                            );
+#endif // XML_PARSER_COMPILE
+
+/** \brief Selects the scanning kernels (AVX2, SSSE3, SSE2 or scalar) supported by the CPU.
+ * It is called implicitly at the first scan, call it explicitly to select the kernels before
+ * starting the parsing threads. Environment variable XML_PARSER_KERNEL ("scalar", "sse2", "ssse3" or "avx2")
+ * limits the selection to the given kernel, e.g. XML_PARSER_KERNEL=scalar for A/B benchmarking.
+ * If XML_PARSER_CPU_DISPATCH is disabled or not supported by the target, kernels are selected at compile time.
+ *
+ * \return const char* : Name of selected kernels.
+ *
+ */
+extern const char* xml_parser_init_cpu(void);
 #endif // PARSE_XML_H
 
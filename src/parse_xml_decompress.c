@@ -0,0 +1,482 @@
+/**
+ * \file
+ * \brief   Decompressing (gzip/zstd) stream front end of XML parser
+
+ * \author  Nandkishor Biradar
+ * \date    16 October 2026
+
+ *  Copyright (c) 2019-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  ------------------------------ INCLUDE FILES ------------------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "parse_xml_decompress.h"
+#include "parse_xml_internal.h"
+
+#if XML_DECOMPRESS_ZLIB
+  #include <zlib.h>
+#endif // XML_DECOMPRESS_ZLIB
+
+#if XML_DECOMPRESS_ZSTD
+  #include <zstd.h>
+#endif // XML_DECOMPRESS_ZSTD
+
+#if XML_DECOMPRESS_THREAD
+  #include <pthread.h>
+#endif // XML_DECOMPRESS_THREAD
+
+/*
+ *  ------------------------------- DEFINITION -------------------------------
+ */
+
+#if XML_PARSER_CONTEXT
+  #define CONTEXT_PTR , void* context
+  #define CONTEXT_ARG , context
+#else
+  #define CONTEXT_PTR
+  #define CONTEXT_ARG
+#endif // XML_PARSER_CONTEXT
+
+/*
+ *  -------------------------------- STRUCTURE --------------------------------
+ */
+
+//! Holds the state of decompression of a stream.
+typedef struct
+{
+  FILE* Stream;                   //!< Stream of compressed input
+  xml_compression_t Compression;  //!< Detected compression format
+  bool End;                       //!< End of stream is reached
+  bool Complete;                  //!< Last compressed frame is complete
+  bool Error;                     //!< Failed to read or decompress the stream
+  const uint8_t* Next;            //!< Next compressed byte to decompress
+  size_t Available;               //!< Number of compressed bytes available from Next
+#if XML_DECOMPRESS_ZLIB
+  z_stream Zlib;                  //!< zlib inflate state
+#endif // XML_DECOMPRESS_ZLIB
+#if XML_DECOMPRESS_ZSTD
+  ZSTD_DCtx* Zstd;                //!< zstd decompression context
+#endif // XML_DECOMPRESS_ZSTD
+  uint8_t Input[XML_DECOMPRESS_CHUNK_SIZE];   //!< Compressed chunk read from the stream
+}decompressor_t;
+
+//! Holds the decompressed chunks and state of parsing of a stream.
+typedef struct
+{
+  decompressor_t Decompressor;
+  xml_parser_t Parser;
+  char* Chunk;                    //!< Decompressed chunks, each of XML_DECOMPRESS_CHUNK_SIZE
+  char Buffer[XML_DECOMPRESS_BUFFER_SIZE];    //!< Parser buffer
+#if XML_DECOMPRESS_THREAD
+  pthread_mutex_t Lock;
+  pthread_cond_t Filled;          //!< Signaled when decompressed chunk is queued
+  pthread_cond_t Emptied;         //!< Signaled when parser releases the chunk or stops
+  size_t Length[XML_DECOMPRESS_CHUNKS];       //!< Length of each queued chunk. 0 marks end of stream.
+  uint32_t Head;                  //!< Count of chunks queued by decompression thread
+  uint32_t Tail;                  //!< Count of chunks released by parser
+  bool Stop;                      //!< Parser doesn't need any more chunks
+#endif // XML_DECOMPRESS_THREAD
+}xml_stream_t;
+
+/*
+ *  ------------------------------ FUNCTION BODY ------------------------------
+ */
+
+/** \brief Reads next compressed chunk from stream, if all the previous one is consumed.
+ *
+ * \param decompressor decompressor_t* const : Decompressor state.
+ *
+ */
+static inline void read_input(decompressor_t* const decompressor)
+{
+  if((decompressor->Available > 0) || decompressor->End)
+  {
+    return;
+  }
+
+  decompressor->Next = decompressor->Input;
+  decompressor->Available = fread(decompressor->Input, 1, sizeof(decompressor->Input), decompressor->Stream);
+  if(decompressor->Available == 0)
+  {
+    decompressor->End = true;
+    decompressor->Error |= (ferror(decompressor->Stream) != 0);
+  }
+}
+
+/** \brief Detects the compression format and initializes the decompressor.
+ *
+ * \param decompressor decompressor_t* const : Decompressor state.
+ * \param stream FILE* : Stream of compressed input.
+ * \param compression xml_compression_t : Compression format of stream.
+ * \return bool : true on success, false if format is not supported or failed to initialize.
+ *
+ */
+static inline bool init_decompressor(decompressor_t* const decompressor, FILE* stream,
+                                     xml_compression_t compression)
+{
+  static const uint8_t GZIP_MAGIC[] = {0x1F, 0x8B};
+  static const uint8_t ZSTD_MAGIC[] = {0x28, 0xB5, 0x2F, 0xFD};
+
+  decompressor->Stream    = stream;
+  decompressor->End       = false;
+  decompressor->Error     = false;
+  decompressor->Available = 0;
+  read_input(decompressor);
+
+  if(compression == EN_COMPRESSION_AUTO)
+  {
+    compression = EN_COMPRESSION_NONE;
+    if((decompressor->Available >= sizeof(GZIP_MAGIC)) &&
+       (memcmp(decompressor->Next, GZIP_MAGIC, sizeof(GZIP_MAGIC)) == 0))
+    {
+      compression = EN_COMPRESSION_GZIP;
+    }
+    else if((decompressor->Available >= sizeof(ZSTD_MAGIC)) &&
+            (memcmp(decompressor->Next, ZSTD_MAGIC, sizeof(ZSTD_MAGIC)) == 0))
+    {
+      compression = EN_COMPRESSION_ZSTD;
+    }
+  }
+
+  decompressor->Compression = compression;
+  decompressor->Complete    = (compression == EN_COMPRESSION_NONE);
+  switch(compression)
+  {
+  case EN_COMPRESSION_NONE:
+    return true;
+
+#if XML_DECOMPRESS_ZLIB
+  case EN_COMPRESSION_GZIP:
+    memset(&decompressor->Zlib, 0, sizeof(decompressor->Zlib));
+    // Window bits 15 + 32 detects gzip or zlib header automatically.
+    return inflateInit2(&decompressor->Zlib, 15 + 32) == Z_OK;
+#endif // XML_DECOMPRESS_ZLIB
+
+#if XML_DECOMPRESS_ZSTD
+  case EN_COMPRESSION_ZSTD:
+    decompressor->Zstd = ZSTD_createDCtx();
+    return decompressor->Zstd != NULL;
+#endif // XML_DECOMPRESS_ZSTD
+
+  default:
+    return false;
+  }
+}
+
+/** \brief Releases the decompressor state.
+ *
+ * \param decompressor decompressor_t* const : Decompressor state.
+ *
+ */
+static inline void close_decompressor(decompressor_t* const decompressor)
+{
+  switch(decompressor->Compression)
+  {
+#if XML_DECOMPRESS_ZLIB
+  case EN_COMPRESSION_GZIP:
+    inflateEnd(&decompressor->Zlib);
+    break;
+#endif // XML_DECOMPRESS_ZLIB
+
+#if XML_DECOMPRESS_ZSTD
+  case EN_COMPRESSION_ZSTD:
+    ZSTD_freeDCtx(decompressor->Zstd);
+    break;
+#endif // XML_DECOMPRESS_ZSTD
+
+  default:
+    break;
+  }
+}
+
+/** \brief Decompresses available compressed input to output buffer.
+ *
+ * \param decompressor decompressor_t* const : Decompressor state.
+ * \param output char* : Output buffer.
+ * \param size size_t  : Size of output buffer.
+ * \return size_t : Number of bytes written to output buffer.
+ *
+ */
+static inline size_t decompress_step(decompressor_t* const decompressor, char* output, size_t size)
+{
+  switch(decompressor->Compression)
+  {
+  case EN_COMPRESSION_NONE:
+  {
+    size_t length = (decompressor->Available < size) ? decompressor->Available : size;
+    memcpy(output, decompressor->Next, length);
+    decompressor->Next      += length;
+    decompressor->Available -= length;
+    return length;
+  }
+
+#if XML_DECOMPRESS_ZLIB
+  case EN_COMPRESSION_GZIP:
+  {
+    if(decompressor->Complete &&
+       ((decompressor->Next[0] != 0x1F) || ((decompressor->Available > 1) && (decompressor->Next[1] != 0x8B))))
+    {
+      // Trailing bytes (e.g. zero padding) that don't start the next gzip member are ignored as by gzip -d.
+      decompressor->Available = 0;
+      decompressor->End       = true;
+      return 0;
+    }
+
+    z_stream* const zlib = &decompressor->Zlib;
+    zlib->next_in   = (uint8_t*)decompressor->Next;
+    zlib->avail_in  = (uInt)decompressor->Available;
+    zlib->next_out  = (uint8_t*)output;
+    zlib->avail_out = (uInt)size;
+
+    int status = inflate(zlib, Z_NO_FLUSH);
+    decompressor->Next      = zlib->next_in;
+    decompressor->Available = zlib->avail_in;
+    decompressor->Complete  = (status == Z_STREAM_END);
+    if(status == Z_STREAM_END)
+    {
+      // Next gzip member may follow.
+      inflateReset(zlib);
+    }
+    else if(status != Z_OK)
+    {
+      decompressor->Error = (status != Z_BUF_ERROR);
+    }
+    return size - zlib->avail_out;
+  }
+#endif // XML_DECOMPRESS_ZLIB
+
+#if XML_DECOMPRESS_ZSTD
+  case EN_COMPRESSION_ZSTD:
+  {
+    ZSTD_inBuffer input = {decompressor->Next, decompressor->Available, 0};
+    ZSTD_outBuffer out  = {output, size, 0};
+
+    size_t status = ZSTD_decompressStream(decompressor->Zstd, &out, &input);
+    decompressor->Next      += input.pos;
+    decompressor->Available -= input.pos;
+    decompressor->Error     = ZSTD_isError(status);
+    // Zero indicates that frame is completely decoded and flushed.
+    decompressor->Complete  = (status == 0);
+    return out.pos;
+  }
+#endif // XML_DECOMPRESS_ZSTD
+
+  default:
+    decompressor->Error = true;
+    return 0;
+  }
+}
+
+/** \brief Fills the output buffer with decompressed XML.
+ *
+ * \param decompressor decompressor_t* const : Decompressor state.
+ * \param output char* : Output buffer.
+ * \param size size_t  : Size of output buffer.
+ * \return size_t : Number of bytes written to output buffer.
+ *                  It is less than size only at the end of stream or on error.
+ *
+ */
+static size_t decompress(decompressor_t* const decompressor, char* output, size_t size)
+{
+  size_t length = 0;
+  while((length < size) && !decompressor->Error)
+  {
+    read_input(decompressor);
+    size_t available = decompressor->Available;
+    if((available == 0) && decompressor->Complete)
+    {
+      break;
+    }
+
+    size_t produced = decompress_step(decompressor, &output[length], size - length);
+    length += produced;
+    if((produced == 0) && (available == 0))
+    {
+      // Stream is truncated in the middle of compressed frame.
+      decompressor->Error = true;
+    }
+  }
+  // Bytes decompressed before an error are returned, error ends the stream on the next call.
+  return length;
+}
+
+/** \brief Decompresses and parses the stream on the calling thread.
+ *
+ * \param stream xml_stream_t* const : Stream state.
+ * \return xml_parse_result_t result of XML parsing.
+ *
+ */
+static xml_parse_result_t parse_sequential(xml_stream_t* const stream)
+{
+  size_t length;
+  while((stream->Parser.Result == XML_INCOMPLETE_SOURCE) &&
+        ((length = decompress(&stream->Decompressor, stream->Chunk, XML_DECOMPRESS_CHUNK_SIZE)) > 0))
+  {
+    xml_parse_feed(&stream->Parser, stream->Chunk, length);
+  }
+  return stream->Parser.Result;
+}
+
+#if XML_DECOMPRESS_THREAD
+/** \brief Decompression thread. Queues the decompressed chunks till the end of stream or parser stops.
+ *
+ * \param argument void* : Stream state.
+ * \return void* : NULL
+ *
+ */
+static void* decompress_thread(void* argument)
+{
+  xml_stream_t* const stream = argument;
+  size_t length;
+
+  do
+  {
+    pthread_mutex_lock(&stream->Lock);
+    while(((stream->Head - stream->Tail) == XML_DECOMPRESS_CHUNKS) && !stream->Stop)
+    {
+      pthread_cond_wait(&stream->Emptied, &stream->Lock);
+    }
+    bool stop = stream->Stop;
+    pthread_mutex_unlock(&stream->Lock);
+    if(stop)
+    {
+      break;
+    }
+
+    uint32_t slot = stream->Head % XML_DECOMPRESS_CHUNKS;
+    length = decompress(&stream->Decompressor, &stream->Chunk[slot * XML_DECOMPRESS_CHUNK_SIZE],
+                        XML_DECOMPRESS_CHUNK_SIZE);
+
+    pthread_mutex_lock(&stream->Lock);
+    stream->Length[slot] = length;
+    stream->Head++;
+    pthread_cond_signal(&stream->Filled);
+    pthread_mutex_unlock(&stream->Lock);
+  }while(length > 0);
+
+  return NULL;
+}
+
+/** \brief Parses the chunks queued by decompression thread.
+ *
+ * \param stream xml_stream_t* const : Stream state.
+ * \return xml_parse_result_t result of XML parsing.
+ *
+ */
+static xml_parse_result_t parse_pipeline(xml_stream_t* const stream)
+{
+  pthread_t thread;
+  stream->Head = 0;
+  stream->Tail = 0;
+  stream->Stop = false;
+  if(pthread_mutex_init(&stream->Lock, NULL) != 0)
+  {
+    return parse_sequential(stream);
+  }
+  if(pthread_cond_init(&stream->Filled, NULL) != 0)
+  {
+    pthread_mutex_destroy(&stream->Lock);
+    return parse_sequential(stream);
+  }
+  if(pthread_cond_init(&stream->Emptied, NULL) != 0)
+  {
+    pthread_cond_destroy(&stream->Filled);
+    pthread_mutex_destroy(&stream->Lock);
+    return parse_sequential(stream);
+  }
+  if(pthread_create(&thread, NULL, decompress_thread, stream) != 0)
+  {
+    pthread_cond_destroy(&stream->Emptied);
+    pthread_cond_destroy(&stream->Filled);
+    pthread_mutex_destroy(&stream->Lock);
+    return parse_sequential(stream);
+  }
+
+  while(stream->Parser.Result == XML_INCOMPLETE_SOURCE)
+  {
+    pthread_mutex_lock(&stream->Lock);
+    while(stream->Head == stream->Tail)
+    {
+      pthread_cond_wait(&stream->Filled, &stream->Lock);
+    }
+    uint32_t slot = stream->Tail % XML_DECOMPRESS_CHUNKS;
+    size_t length = stream->Length[slot];
+    pthread_mutex_unlock(&stream->Lock);
+    if(length == 0)
+    {
+      break;
+    }
+
+    xml_parse_feed(&stream->Parser, &stream->Chunk[slot * XML_DECOMPRESS_CHUNK_SIZE], length);
+
+    pthread_mutex_lock(&stream->Lock);
+    stream->Tail++;
+    pthread_cond_signal(&stream->Emptied);
+    pthread_mutex_unlock(&stream->Lock);
+  }
+
+  pthread_mutex_lock(&stream->Lock);
+  stream->Stop = true;
+  pthread_cond_signal(&stream->Emptied);
+  pthread_mutex_unlock(&stream->Lock);
+  pthread_join(thread, NULL);
+
+  pthread_cond_destroy(&stream->Emptied);
+  pthread_cond_destroy(&stream->Filled);
+  pthread_mutex_destroy(&stream->Lock);
+  return stream->Parser.Result;
+}
+#endif // XML_DECOMPRESS_THREAD
+
+xml_parse_result_t parse_xml_compressed(const xs_element_t* root, FILE* file,
+                                        xml_compression_t compression, bool pipeline,
+                                        void* const target
+                                        CONTEXT_PTR)
+{
+#if !XML_DECOMPRESS_THREAD
+  pipeline = false;
+#endif // XML_DECOMPRESS_THREAD
+
+  xml_stream_t* const stream = malloc(sizeof(xml_stream_t));
+  ASSERT(stream != NULL, FAILED_TO_ALLOCATE_MEMORY, "Failed to allocate the stream state.\n");
+  stream->Chunk = malloc(pipeline ? (XML_DECOMPRESS_CHUNKS * XML_DECOMPRESS_CHUNK_SIZE) : XML_DECOMPRESS_CHUNK_SIZE);
+  if(stream->Chunk == NULL)
+  {
+    free(stream);
+    return FAILED_TO_ALLOCATE_MEMORY;
+  }
+
+  xml_parse_result_t result = XML_DECOMPRESS_ERROR;
+  if(init_decompressor(&stream->Decompressor, file, compression))
+  {
+    xml_parser_init(&stream->Parser, root, target, stream->Buffer, sizeof(stream->Buffer) CONTEXT_ARG);
+#if XML_DECOMPRESS_THREAD
+    result = pipeline ? parse_pipeline(stream) : parse_sequential(stream);
+#else
+    result = parse_sequential(stream);
+#endif // XML_DECOMPRESS_THREAD
+
+    if(result == XML_INCOMPLETE_SOURCE)
+    {
+      result = stream->Decompressor.Error ? XML_DECOMPRESS_ERROR : xml_parse_finish(&stream->Parser);
+    }
+    close_decompressor(&stream->Decompressor);
+  }
+
+  free(stream->Chunk);
+  free(stream);
+  return result;
+}
@@ -0,0 +1,112 @@
+#ifndef PARSE_XML_DECOMPRESS_H
+#define PARSE_XML_DECOMPRESS_H
+
+/**
+ * \file
+ * \brief Decompressing (gzip/zstd) stream front end of XML parser
+
+ * \author  Nandkishor Biradar
+ * \date    16 October 2026
+
+ *  Copyright (c) 2019-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  ------------------------------ INCLUDE FILES ------------------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "parse_xml.h"
+
+/*
+ *  ------------------------------- DEFINITION -------------------------------
+ */
+
+//! Enable gzip/zlib decompression. Requires linking with zlib (-lz).
+#ifndef XML_DECOMPRESS_ZLIB
+  #define XML_DECOMPRESS_ZLIB 1
+#endif // XML_DECOMPRESS_ZLIB
+
+//! Enable zstd decompression. Requires linking with libzstd (-lzstd).
+#ifndef XML_DECOMPRESS_ZSTD
+  #define XML_DECOMPRESS_ZSTD 1
+#endif // XML_DECOMPRESS_ZSTD
+
+//! Enable decompression on a separate thread. Requires POSIX threads (-pthread).
+#ifndef XML_DECOMPRESS_THREAD
+  #ifdef _WIN32
+    #define XML_DECOMPRESS_THREAD 0
+  #else
+    #define XML_DECOMPRESS_THREAD 1
+  #endif // _WIN32
+#endif // XML_DECOMPRESS_THREAD
+
+//! Size of chunk of compressed input read from the stream and of decompressed XML fed to the parser.
+#ifndef XML_DECOMPRESS_CHUNK_SIZE
+  #define XML_DECOMPRESS_CHUNK_SIZE (64 * 1024)
+#endif // XML_DECOMPRESS_CHUNK_SIZE
+
+#if XML_DECOMPRESS_CHUNK_SIZE < 4
+  #error "XML_DECOMPRESS_CHUNK_SIZE must hold the magic number of compressed stream."
+#endif
+
+//! Number of decompressed chunks queued between decompression thread and parser.
+#ifndef XML_DECOMPRESS_CHUNKS
+  #define XML_DECOMPRESS_CHUNKS 4
+#endif // XML_DECOMPRESS_CHUNKS
+
+//! Size of parser buffer that joins an XML token split across two decompressed chunks.
+#ifndef XML_DECOMPRESS_BUFFER_SIZE
+  #define XML_DECOMPRESS_BUFFER_SIZE 4096
+#endif // XML_DECOMPRESS_BUFFER_SIZE
+
+/*
+ *  ------------------------------- ENUMERATION -------------------------------
+ */
+
+//! Compression format of XML stream
+typedef enum
+{
+  EN_COMPRESSION_AUTO,    //!< Detect the format from magic number of the stream.
+  EN_COMPRESSION_NONE,    //!< Plain XML.
+  EN_COMPRESSION_GZIP,    //!< gzip or zlib format. Concatenated gzip members are supported, trailing padding is ignored.
+  EN_COMPRESSION_ZSTD,    //!< zstd format. Concatenated zstd frames are supported.
+}xml_compression_t;
+
+/*
+ *  ---------------------------- EXPORTED FUNCTION ----------------------------
+ */
+
+/** \brief Parses the XML from a (compressed) stream in bounded chunks.
+ * Memory used is constant: XML_DECOMPRESS_CHUNKS (1 if not pipelined) decompressed chunks,
+ * one compressed chunk and the decompressor state, irrespective of size of the stream.
+ * As the chunks are reused, content of EN_STRING type is valid only in the element callback.
+ *
+ * \param root const xs_element_t*        : Pointer to root element of XML element tree.
+ * \param file FILE*                      : Stream to read from. It is not closed.
+ * \param compression xml_compression_t   : Compression format of the stream.
+ * \param pipeline bool                   : Decompress on a separate thread while parsing.
+ *                                          Ignored if XML_DECOMPRESS_THREAD is disabled.
+ * \param target void* const              : Target address to store content of XML element in case of relative addressing type.
+ * \param context void*                   : User defined context.
+ * \return xml_parse_result_t result of XML parsing.
+ *         XML_DECOMPRESS_ERROR if failed to read or decompress the stream or the format is not supported.
+ *
+ */
+extern xml_parse_result_t parse_xml_compressed(const xs_element_t* root, FILE* file,
+                                               xml_compression_t compression, bool pipeline,
+                                               void* const target
+                                              #if XML_PARSER_CONTEXT
+                                                , void* context
+                                              #endif // XML_PARSER_CONTEXT
+                                              );
+
+#endif // PARSE_XML_DECOMPRESS_H
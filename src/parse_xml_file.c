@@ -0,0 +1,149 @@
+/**
+ * \file
+ * \brief   Memory mapped XML file front end of XML parser
+
+ * \author  Nandkishor Biradar
+ * \date    16 October 2026
+
+ *  Copyright (c) 2019-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  ------------------------------ INCLUDE FILES ------------------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif // _WIN32
+
+#include "parse_xml_file.h"
+#include "parse_xml_internal.h"
+
+/*
+ *  ------------------------------- DEFINITION -------------------------------
+ */
+
+#if XML_PARSER_CONTEXT
+  #define CONTEXT_PTR , void* context
+  #define CONTEXT_ARG , context
+#else
+  #define CONTEXT_PTR
+  #define CONTEXT_ARG
+#endif // XML_PARSER_CONTEXT
+
+/*
+ *  ------------------------------ FUNCTION BODY ------------------------------
+ */
+
+/** \brief Maps the file read-only in memory.
+ *
+ * \param path const char* : Path of file to map.
+ * \param file xml_file_t* const : Holds the address and size of memory mapped file.
+ * \return bool : true on success otherwise false.
+ */
+static inline bool map_file(const char* path, xml_file_t* const file)
+{
+#ifdef _WIN32
+  HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if(handle == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  HANDLE mapping = NULL;
+  if(GetFileSizeEx(handle, &size) && (size.QuadPart > 0))
+  {
+    mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+  }
+  CloseHandle(handle);
+  if(mapping == NULL)
+  {
+    return false;
+  }
+
+  // View holds the reference of mapping object.
+  file->Source = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  file->Size = (size_t)size.QuadPart;
+  return file->Source != NULL;
+#else
+  int descriptor = open(path, O_RDONLY);
+  if(descriptor < 0)
+  {
+    return false;
+  }
+
+  struct stat status;
+  if((fstat(descriptor, &status) != 0) || (status.st_size <= 0))
+  {
+    close(descriptor);
+    return false;
+  }
+
+  int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  if(status.st_size < XML_FILE_POPULATE_SIZE)
+  {
+    flags |= MAP_POPULATE;
+  }
+#endif // MAP_POPULATE
+
+  // Mapping holds the reference of file.
+  void* source = mmap(NULL, (size_t)status.st_size, PROT_READ, flags, descriptor, 0);
+  close(descriptor);
+  if(source == MAP_FAILED)
+  {
+    return false;
+  }
+
+#ifdef MADV_SEQUENTIAL
+  madvise(source, (size_t)status.st_size, MADV_SEQUENTIAL);
+  madvise(source, (size_t)status.st_size, MADV_WILLNEED);
+#endif // MADV_SEQUENTIAL
+
+  file->Source = source;
+  file->Size   = (size_t)status.st_size;
+  return true;
+#endif // _WIN32
+}
+
+xml_parse_result_t parse_xml_file(const xs_element_t* root, const char* path,
+                                  void* const target, xml_file_t* const file
+                                  CONTEXT_PTR)
+{
+  file->Source = NULL;
+  file->Size   = 0;
+  ASSERT(map_file(path, file), XML_FILE_ERROR, "Failed to open or map the XML file '%s'.\n", path);
+  return parse_xml_n(root, file->Source, file->Size, target CONTEXT_ARG);
+}
+
+void xml_file_close(xml_file_t* const file)
+{
+  if(file->Source == NULL)
+  {
+    return;
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(file->Source);
+#else
+  munmap((void*)file->Source, file->Size);
+#endif // _WIN32
+  file->Source = NULL;
+  file->Size   = 0;
+}
@@ -0,0 +1,77 @@
+#ifndef PARSE_XML_FILE_H
+#define PARSE_XML_FILE_H
+
+/**
+ * \file
+ * \brief Memory mapped XML file front end of XML parser
+
+ * \author  Nandkishor Biradar
+ * \date    16 October 2026
+
+ *  Copyright (c) 2019-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  ------------------------------ INCLUDE FILES ------------------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "parse_xml.h"
+
+/*
+ *  ------------------------------- DEFINITION -------------------------------
+ */
+
+//! Files smaller than this size are pre-faulted (MAP_POPULATE) while mapping.
+#ifndef XML_FILE_POPULATE_SIZE
+  #define XML_FILE_POPULATE_SIZE  (1024 * 1024)
+#endif // XML_FILE_POPULATE_SIZE
+
+/*
+ *  -------------------------------- STRUCTURE --------------------------------
+ */
+
+//! Structure to hold the memory mapped XML file.
+typedef struct
+{
+  const char* Source;   //!< Address of memory mapped XML file. NULL if file is not mapped.
+  size_t Size;          //!< Size of XML file.
+}xml_file_t;
+
+/*
+ *  ---------------------------- EXPORTED FUNCTION ----------------------------
+ */
+
+/** \brief Maps the XML file read-only in memory and parses it without copying.
+ * The file stays mapped after parsing, as content of EN_STRING type points into the mapping.
+ * Call \ref xml_file_close once the content is no longer used, irrespective of the result of parsing.
+ *
+ * \param root const xs_element_t*: Pointer to root element of XML element tree.
+ * \param path const char*        : Path of XML file to parse.
+ * \param target void* const      : Target address to store content of XML element in case of relative addressing type.
+ * \param file xml_file_t* const  : Holds the memory mapped XML file.
+ * \param context void*           : User defined context.
+ * \return xml_parse_result_t result of XML parsing. XML_FILE_ERROR if failed to open or map the file.
+ *
+ */
+extern xml_parse_result_t parse_xml_file(const xs_element_t* root, const char* path,
+                                         void* const target, xml_file_t* const file
+                                        #if XML_PARSER_CONTEXT
+                                          , void* context
+                                        #endif // XML_PARSER_CONTEXT
+                                        );
+
+/** \brief Unmaps the XML file mapped by \ref parse_xml_file.
+ *
+ * \param file xml_file_t* const : Memory mapped XML file.
+ *
+ */
+extern void xml_file_close(xml_file_t* const file);
+
+#endif // PARSE_XML_FILE_H
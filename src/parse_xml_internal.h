@@ -19,10 +19,17 @@
  *  ------------------------------ INCLUDE FILES ------------------------------
  */
 
+#include <stdlib.h>
+
 #if XML_PARSER_DEBUG
 #include "stdio.h"
 #endif // XML_PARSER_DEBUG
 
+#if XML_PARSER_LOOKUP
+#include <stdint.h>
+#include <string.h>
+#endif // XML_PARSER_LOOKUP
+
  /*
  *  ------------------------------- DEFINITION -------------------------------
  */
@@ -50,5 +57,136 @@ do {                                \
 
 #endif // XML_PARSER_DEBUG
 
+/*
+ *  ------------------------------ FUNCTION BODY ------------------------------
+ */
+
+/** \brief Allocates the memory from the allocator of parser.
+ *
+ * \param allocator const xml_allocator_t* : allocator. NULL to allocate using malloc.
+ * \param size size_t : size of memory
+ * \return void* : allocated memory. NULL on failure.
+ */
+static inline void* xml_allocate(const xml_allocator_t* allocator, size_t size)
+{
+  return (allocator != NULL) ? allocator->Alloc(allocator->State, size) : malloc(size);
+}
+
+/** \brief Resizes the memory allocated from the allocator of parser.
+ *
+ * \param allocator const xml_allocator_t* : allocator. NULL to resize using realloc.
+ * \param memory void* : memory to resize. NULL if old size is 0.
+ * \param old_size size_t : current size of memory
+ * \param size size_t : new size of memory
+ * \return void* : resized memory. NULL on failure, then memory is not freed.
+ */
+static inline void* xml_reallocate(const xml_allocator_t* allocator, void* memory, size_t old_size, size_t size)
+{
+  return (allocator != NULL) ? allocator->Realloc(allocator->State, memory, old_size, size) : realloc(memory, size);
+}
+
+#if XML_PARSER_LOOKUP
+/** \brief First 8 bytes of name, zero padded if name is shorter.
+ *  Shorter name is copied with fixed size copies (overlapping for 4 to 7 bytes), as a copy of variable size is a library call.
+ *
+ * \param name const char* : name of element or attribute
+ * \param length size_t : length of name
+ * \return uint64_t : prefix of name
+ */
+static inline uint64_t get_name_prefix(const char* name, size_t length)
+{
+  uint64_t prefix = 0;
+  if(length >= 8)
+  {
+    memcpy(&prefix, name, 8);
+    return prefix;
+  }
+
+  uint8_t bytes[8] = {0};
+  if(length >= 4)
+  {
+    memcpy(bytes, name, 4);
+    memcpy(&bytes[length - 4], name + length - 4, 4);
+  }
+  else if(length > 0)
+  {
+    bytes[0] = (uint8_t)name[0];
+    bytes[length / 2] = (uint8_t)name[length / 2];
+    bytes[length - 1] = (uint8_t)name[length - 1];
+  }
+  memcpy(&prefix, bytes, 8);
+  return prefix;
+}
+
+/** \brief Hash of name made of its length and the first and last 8 bytes.
+ *
+ * \param name const char* : name of element, attribute or string enumeration
+ * \param length size_t : length of name
+ * \return uint64_t : hash of name
+ */
+static inline uint64_t get_name_hash(const char* name, size_t length)
+{
+  const uint64_t first = get_name_prefix(name, length);
+  uint64_t last = 0;
+  if(length >= 8)
+  {
+    memcpy(&last, name + length - 8, 8);
+  }
+  const uint64_t hash = (first ^ (last * 0x9E3779B97F4A7C15ULL) ^ length) * 0xBF58476D1CE4E5B9ULL;
+  return hash ^ (hash >> 31);
+}
+
+/** \brief Hash of unsigned integer enumeration.
+ *
+ * \param value uint32_t : value of enumeration
+ * \return uint64_t : hash of value
+ */
+static inline uint64_t get_value_hash(uint32_t value)
+{
+  const uint64_t hash = (value ^ 0x9E3779B97F4A7C15ULL) * 0xBF58476D1CE4E5B9ULL;
+  return hash ^ (hash >> 31);
+}
+
+/** \brief Returns the bucket of hash. Upper half of hash is mapped to buckets.
+ *
+ * \param hash uint64_t : hash of name
+ * \param buckets uint32_t : Number of buckets
+ * \return uint32_t : bucket of hash
+ */
+static inline uint32_t get_lookup_bucket(uint64_t hash, uint32_t buckets)
+{
+  return (uint32_t)(((hash >> 32) * buckets) >> 32);
+}
+
+/** \brief Returns the slot of hash displaced by displacement of its bucket. Lower half of hash is mapped to slots.
+ *
+ * \param hash uint64_t : hash of name
+ * \param displacement uint32_t : displacement of bucket of hash
+ * \param quantity uint32_t : Number of slots
+ * \return uint32_t : slot of hash
+ */
+static inline uint32_t get_lookup_slot(uint64_t hash, uint32_t displacement, uint32_t quantity)
+{
+  uint32_t slot = (uint32_t)hash ^ (displacement * 0x9E3779B9U);
+  slot = (slot ^ (slot >> 16)) * 0x85EBCA6BU;
+  slot = (slot ^ (slot >> 13)) * 0xC2B2AE35U;
+  slot ^= slot >> 16;
+  return (uint32_t)(((uint64_t)slot * quantity) >> 32);
+}
+
+/** \brief Finds the only candidate index of hash in the lookup. Caller must compare the entry at the index.
+ *
+ * \param lookup const xs_lookup_t* const : Lookup built by \ref xs_lookup_init
+ * \param hash uint64_t : hash of name or value to find
+ * \return uint32_t : index of entry, if entry is present in the lookup.
+ */
+static inline uint32_t lookup_hash(const xs_lookup_t* const lookup, uint64_t hash)
+{
+  const uint32_t buckets = (lookup->Quantity + 1) / 2;
+  const uint32_t displacement = lookup->Table[get_lookup_bucket(hash, buckets)];
+  return lookup->Table[buckets + get_lookup_slot(hash, displacement, lookup->Quantity)];
+}
+#endif // XML_PARSER_LOOKUP
+
 #endif // PARSE_XML_INTERNAL_H
 
@@ -24,10 +24,86 @@
 #include "parse_xml.h"
 #include "parse_xml_internal.h"
 
+/*
+ *  ------------------------------- DEFINITION -------------------------------
+ */
+
+//! Rounds up the size of arena allocation to 8 bytes.
+#define ARENA_ALIGN(size)  (((size) + 7) & ~(size_t)7)
+
+/*
+ *  -------------------------------- STRUCTURE --------------------------------
+ */
+
+//! Header of block of arena. Memory of block follows it.
+struct xml_arena_block_t
+{
+  xml_arena_block_t* Previous;  //!< Previously allocated block. NULL for the first block.
+  size_t Size;                  //!< Size of memory of block
+};
+
 /*
  *  ------------------------------ FUNCTION BODY ------------------------------
  */
 
+/** \brief Converts the integer string to value within the bound of source. Similar to strtol.
+ *
+ * \param source const char*    XML content source
+ * \param end const char*const  End of XML content source
+ * \param pValue int64_t*       Target to store converted value.
+ * \return const char*          Address of first char after the integer string.
+ *
+ */
+static inline const char* get_integer(const char* source, const char* const end, int64_t* pValue)
+{
+  bool negative = false;
+  uint64_t value = 0;
+
+  while((source < end) && ((*source == ' ') || (*source == '\t') || (*source == '\r') || (*source == '\n')))
+  {
+    source++;
+  }
+
+  if((source < end) && ((*source == '-') || (*source == '+')))
+  {
+    negative = (*source++ == '-');
+  }
+
+  while((source < end) && (*source >= '0') && (*source <= '9'))
+  {
+    value = (value * 10) + (uint64_t)(*source++ - '0');
+  }
+
+  *pValue = negative ? -(int64_t)value : (int64_t)value;
+  return source;
+}
+
+/** \brief Converts the decimal string to float value within the bound of source. Similar to strtof.
+ *
+ * \param source const char*    XML content source
+ * \param end const char*const  End of XML content source
+ * \return float                Converted value
+ *
+ */
+static inline float get_decimal(const char* source, const char* const end)
+{
+  char number[64];
+
+  while((source < end) && ((*source == ' ') || (*source == '\t') || (*source == '\r') || (*source == '\n')))
+  {
+    source++;
+  }
+
+  size_t length = end - source;
+  if(length >= sizeof(number))
+  {
+    length = sizeof(number) - 1;
+  }
+  memcpy(number, source, length);
+  number[length] = '\0';
+  return strtof(number, NULL);
+}
+
 /** \brief Extract the unsigned value separated by specified token.
  *
  * \param source const char*    XML content source
@@ -43,21 +119,16 @@ static inline const char* get_tokenized_content(const char* source, const char*
   uint32_t i = 0;
   do
   {
-    char* endPtr;
-    uint32_t value = strtoul(source, &endPtr, 10);
-    if(endPtr > end)
-    {
-      return NULL;
-    }
-    source = endPtr;
-    pTarget[i] = value;
+    int64_t value;
+    source = get_integer(source, end, &value);
+    pTarget[i] = (uint32_t)value;
 
     if(++i == 3)
     {
       return source;
     }
 
-    if(token != *source++)
+    if((source >= end) || (token != *source++))
     {
       return NULL;
     }
@@ -77,7 +148,7 @@ static inline xml_parse_result_t get_date_time(const char* source, const char* c
   source = get_tokenized_content(source, end, '-', (uint32_t*)&pTarget->Date);
   ASSERT(source, XML_DATE_TIME_SYNTAX_ERROR, "Syntax error in XML date time content.\n");
 
-  if(*source++ == 'T')
+  if((source < end) && (*source++ == 'T'))
   {
     ASSERT(get_tokenized_content(source, end, ':', (uint32_t*)&pTarget->Time), XML_DATE_TIME_SYNTAX_ERROR,
            "Syntax error in XML date time content.\n");
@@ -100,14 +171,13 @@ static inline bool get_duration_content(const char* source, const char* const en
 {
   for(uint32_t i = 0; (i < 3) && (source < end); i++)
   {
-    char* endptr;
-    uint32_t value = strtoul(source, &endptr, 10);
+    int64_t value;
+    source = get_integer(source, end, &value);
 
-    if(endptr >= end)
+    if(source >= end)
     {
       return false;
     }
-    source = endptr;
     while(pToken[i] != *source++)
     {
       if(++i == 3)
@@ -115,7 +185,7 @@ static inline bool get_duration_content(const char* source, const char* const en
         return false;
       }
     }
-    pTarget[i] = value;
+    pTarget[i] = (uint32_t)value;
 
   }
   return true;
@@ -132,6 +202,7 @@ static inline bool get_duration_content(const char* source, const char* const en
 static inline xml_parse_result_t get_duration(const char* source, const char* const end, xs_duration_t* const duration)
 {
   duration->Sign = true;
+  ASSERT(source < end, XML_DURATION_SYNTAX_ERROR, "Syntax error in XML duration content. Empty content.\n");
   if(*source == '-')
   {
     duration->Sign = false;
@@ -139,6 +210,7 @@ static inline xml_parse_result_t get_duration(const char* source, const char* co
 
   ASSERT(*source++ == 'P', XML_DURATION_SYNTAX_ERROR,
          "Syntax error in XML duration content. Missing 'P' at the start of content.\n");
+  ASSERT(source < end, XML_DURATION_SYNTAX_ERROR, "Syntax error in XML duration content.\n");
 
   if(*source != 'T')
   {
@@ -146,7 +218,7 @@ static inline xml_parse_result_t get_duration(const char* source, const char* co
            "Syntax error in XML duration content.\n");
   }
 
-  if(*source++ == 'T')
+  if((source < end) && (*source++ == 'T'))
   {
     ASSERT(get_duration_content(source, end, "HMS", &duration->Period.Time.Hour), XML_DURATION_SYNTAX_ERROR,
            "Syntax error in XML duration content.\n");
@@ -158,12 +230,22 @@ static inline xml_parse_result_t get_duration(const char* source, const char* co
 xml_parse_result_t extract_content(const xml_content_t* const content,
                             void* target, const char* const source,
                             size_t length)
+{
+  return extract_content_allocator(content, target, source, length, NULL);
+}
+
+xml_parse_result_t extract_content_allocator(const xml_content_t* const content,
+                                      void* target, const char* const source,
+                                      size_t length, const xml_allocator_t* allocator)
 {
   if(target == NULL)
   {
     return XML_PARSE_SUCCESS;
   }
 
+  const char* const end = source + length;
+  int64_t integer;
+
   switch(content->Type)
   {
   case EN_STRING:
@@ -202,7 +284,7 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
            "Length of x:string content '%llu' is greater than '%u' maxLength of restriction facet.\n",
            length, content->Facet.String.MaxLength);
 
-    char* data = (char*)malloc(length + 1);
+    char* data = xml_allocate(allocator, length + 1);
     ASSERT(data!= NULL, FAILED_TO_ALLOCATE_MEMORY, "Failed to allocate dynamic memory for XML string content\n");
     memcpy(data, source, length);
     data[length] = '\0';
@@ -212,7 +294,8 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
 
   case EN_UINT32:
   {
-    uint32_t value = strtoul(source, NULL, 10);
+    get_integer(source, end, &integer);
+    uint32_t value = (uint32_t)integer;
     ASSERT((value >= content->Facet.Uint.MinValue), XML_MIN_VALUE_ERROR,
            "Value of unsigned int content '%d' is less than '%d' minValue of restriction facet.\n",
            value, content->Facet.Uint.MinValue);
@@ -225,7 +308,8 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
 
   case EN_UINT16:
   {
-    uint16_t value = (uint16_t)strtoul(source, NULL, 10);
+    get_integer(source, end, &integer);
+    uint16_t value = (uint16_t)integer;
     ASSERT((value >= content->Facet.Uint.MinValue), XML_MIN_VALUE_ERROR,
            "Value of 16-bit unsigned int content '%d' is less than '%d' minValue of restriction facet.\n",
            value, content->Facet.Uint.MinValue);
@@ -238,7 +322,8 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
 
   case EN_UINT8:
   {
-    uint8_t value = (uint8_t)strtoul(source, NULL, 10);
+    get_integer(source, end, &integer);
+    uint8_t value = (uint8_t)integer;
     ASSERT((value >= content->Facet.Uint.MinValue), XML_MIN_VALUE_ERROR,
            "Value of 8-bit unsigned short content '%d' is less than '%d' minValue of restriction facet.\n",
            value, content->Facet.Uint.MinValue);
@@ -251,7 +336,8 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
 
   case EN_INT32:
   {
-    int32_t value = strtol(source, NULL, 10);
+    get_integer(source, end, &integer);
+    int32_t value = (int32_t)integer;
     ASSERT((value >= content->Facet.Int.MinValue), XML_MIN_VALUE_ERROR,
             "Value of integers content '%d' is less than '%d' minValue of restriction facet.\n",
             value, content->Facet.Int.MinValue);
@@ -264,7 +350,7 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
 
   case EN_DECIMAL:
   {
-    float value = strtof(source, NULL);
+    float value = get_decimal(source, end);
     ASSERT((value >= content->Facet.Decimal.MinValue), XML_MIN_VALUE_ERROR,
             "Value of decimal content '%f' is less than '%f' minValue of restriction facet.\n",
             value, content->Facet.Decimal.MinValue);
@@ -278,6 +364,17 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
   case EN_ENUM_STRING:
   {
     const string_t* const list = content->Facet.Enum.List;
+#if XML_PARSER_LOOKUP
+    const xs_lookup_t* const lookup = content->Facet.Enum.Lookup;
+    if((lookup != NULL) && (lookup->Quantity != 0))
+    {
+      const uint32_t i = lookup_hash(lookup, get_name_hash(source, length));
+      ASSERT((length == list[i].Length) && (memcmp(list[i].String, source, length) == 0), XML_ENUM_NOT_FOUND,
+             "Content '%.*s' does not match with any of specified enumerations.\n", (int)length, source);
+      (*(uint32_t*)target) = i;
+      return XML_PARSE_SUCCESS;
+    }
+#endif // XML_PARSER_LOOKUP
     for(uint32_t i = 0; i < content->Facet.Enum.Quantity; i++)
     {
       if((length == list[i].Length) && (memcmp(list[i].String, source, length) == 0))
@@ -294,8 +391,19 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
 
   case EN_ENUM_UINT:
   {
-    uint32_t value = strtoul(source, NULL, 10);
+    get_integer(source, end, &integer);
+    uint32_t value = (uint32_t)integer;
     const uint32_t* const list = content->Facet.Enum.List;
+#if XML_PARSER_LOOKUP
+    const xs_lookup_t* const lookup = content->Facet.Enum.Lookup;
+    if((lookup != NULL) && (lookup->Quantity != 0))
+    {
+      ASSERT(value == list[lookup_hash(lookup, get_value_hash(value))], XML_ENUM_NOT_FOUND,
+             "Content '%d' does not match with any of specified enumerations.\n", value);
+      (*(uint32_t*)target) = value;
+      return XML_PARSE_SUCCESS;
+    }
+#endif // XML_PARSER_LOOKUP
     for(uint32_t i = 0; i < content->Facet.Enum.Quantity; i++)
     {
       if(value == list[i])
@@ -311,27 +419,163 @@ xml_parse_result_t extract_content(const xml_content_t* const content,
   }
 
   case EN_DURATION:
-    return get_duration(source, source + length, target);
+    return get_duration(source, end, target);
 
   case EN_DATE:
     {
-      const char* const result = get_tokenized_content(source, source + length, '-', target);
+      const char* const result = get_tokenized_content(source, end, '-', target);
       ASSERT(result, XML_DATE_TIME_SYNTAX_ERROR, "Syntax error in XML date content.\n");
       return XML_PARSE_SUCCESS;
     }
 
   case EN_TIME:
     {
-      const char* const result = get_tokenized_content(source, source + length, ':', target);
+      const char* const result = get_tokenized_content(source, end, ':', target);
       ASSERT(result, XML_DATE_TIME_SYNTAX_ERROR, "Syntax error in XML time content.\n");
       return XML_PARSE_SUCCESS;
     }
 
   case EN_DATE_TIME:
-    return get_date_time(source, source + length, target);
+    return get_date_time(source, end, target);
 
   default:
     return XML_CONTENT_UNSUPPORTED;
   }
   return XML_PARSE_SUCCESS;
 }
+
+void xml_arena_init(xml_arena_t* const arena, size_t block_size)
+{
+  arena->Block      = NULL;
+  arena->Large      = NULL;
+  arena->Used       = 0;
+  arena->Block_Size = block_size;
+}
+
+void* xml_arena_alloc(xml_arena_t* const arena, size_t size)
+{
+  size = ARENA_ALIGN(size);
+  const size_t capacity = ARENA_ALIGN(arena->Block_Size);
+  if(size > capacity)
+  {
+    // Large allocation gets its own block, so that free space of the current block is not abandoned.
+    xml_arena_block_t* const large = malloc(sizeof(xml_arena_block_t) + size);
+    if(large == NULL)
+    {
+      return NULL;
+    }
+    large->Previous = arena->Large;
+    large->Size     = size;
+    arena->Large    = large;
+    return large + 1;
+  }
+
+  xml_arena_block_t* block = arena->Block;
+  if((block == NULL) || (block->Size - arena->Used < size))
+  {
+    block = malloc(sizeof(xml_arena_block_t) + capacity);
+    if(block == NULL)
+    {
+      return NULL;
+    }
+    block->Previous = arena->Block;
+    block->Size     = capacity;
+    arena->Block    = block;
+    arena->Used     = 0;
+  }
+
+  void* const memory = (char*)(block + 1) + arena->Used;
+  arena->Used += size;
+  return memory;
+}
+
+void xml_arena_reset(xml_arena_t* const arena)
+{
+  xml_arena_block_t* block = arena->Block;
+  while((block != NULL) && (block->Previous != NULL))
+  {
+    xml_arena_block_t* const previous = block->Previous;
+    free(block);
+    block = previous;
+  }
+  arena->Block = block;
+  arena->Used  = 0;
+
+  block = arena->Large;
+  while(block != NULL)
+  {
+    xml_arena_block_t* const previous = block->Previous;
+    free(block);
+    block = previous;
+  }
+  arena->Large = NULL;
+}
+
+void xml_arena_free(xml_arena_t* const arena)
+{
+  xml_arena_reset(arena);
+  free(arena->Block);
+  arena->Block = NULL;
+}
+
+/** \brief Alloc function of arena allocator.
+ *
+ * \param state void* : arena
+ * \param size size_t : size of memory
+ * \return void* : allocated memory. NULL on failure.
+ */
+static void* arena_alloc(void* state, size_t size)
+{
+  return xml_arena_alloc(state, size);
+}
+
+/** \brief Realloc function of arena allocator. Last allocation of the current block is resized in place.
+ *
+ * \param state void* : arena
+ * \param memory void* : memory to resize
+ * \param old_size size_t : current size of memory
+ * \param size size_t : new size of memory
+ * \return void* : resized memory. NULL on failure.
+ */
+static void* arena_realloc(void* state, void* memory, size_t old_size, size_t size)
+{
+  xml_arena_t* const arena = state;
+  if((memory != NULL) && (size <= old_size))
+  {
+    return memory;
+  }
+
+  xml_arena_block_t* const block = arena->Block;
+  // Large allocations may precede the first block, then there is no block to resize in place.
+  if((memory != NULL) && (block != NULL) && ((char*)memory + ARENA_ALIGN(old_size) == (char*)(block + 1) + arena->Used) &&
+     (ARENA_ALIGN(size) - ARENA_ALIGN(old_size) <= block->Size - arena->Used))
+  {
+    arena->Used += ARENA_ALIGN(size) - ARENA_ALIGN(old_size);
+    return memory;
+  }
+
+  void* const resized = xml_arena_alloc(arena, size);
+  if((resized != NULL) && (memory != NULL))
+  {
+    memcpy(resized, memory, old_size);
+  }
+  return resized;
+}
+
+/** \brief Free function of arena allocator. Memory is released by \ref xml_arena_reset.
+ *
+ * \param state void* : arena
+ * \param memory void* : memory to free
+ * \param size size_t : size of memory
+ */
+static void arena_free(void* state, void* memory, size_t size)
+{
+  (void)state;
+  (void)memory;
+  (void)size;
+}
+
+xml_allocator_t xml_arena_allocator(xml_arena_t* const arena)
+{
+  return (xml_allocator_t){.Alloc = arena_alloc, .Realloc = arena_realloc, .Free = arena_free, .State = arena};
+}
@@ -27,7 +27,7 @@
 #define ALL_XML_CONTENT_TYPES       \
   ADD_CONTENT(EN_NO_XML_DATA_TYPE, XML element does not hold the content)    \
   ADD_CONTENT(EN_STRING,           starting address of string from the imput xml buffer and length of content is copied to string_t)  \
-  ADD_CONTENT(EN_STRING_DYNAMIC,   String will be dynamically allocated using malloc and the pointer is copied to the target) \
+  ADD_CONTENT(EN_STRING_DYNAMIC,   String will be dynamically allocated using malloc (or arena) and the pointer is copied to the target) \
   ADD_CONTENT(EN_CHAR_ARRAY,       String will be directly copied to the target using memcpy)  \
   ADD_CONTENT(EN_ENUM_STRING,      Enumeration)          \
   ADD_CONTENT(EN_ENUM_INT,         Enumeration of integers. e.g. enum { red = 10, green = 50};) \
@@ -145,11 +145,29 @@ typedef struct
   double MaxValue;   //!< Maximum acceptable value
 }double_facet_t;
 
+#if XML_PARSER_LOOKUP
+//! Number of entries of xs_lookup_t table for given number of names or enumerations.
+#define XS_LOOKUP_SIZE(quantity)  ((quantity) + ((quantity) + 1) / 2)
+
+//! Perfect hash of names (hash and displace) to find a child element, an attribute or an enumeration in constant time.
+//! Hash key of name is made of its length and the first and last 8 bytes.
+//! Storage of table is provided by the schema and it is built by \ref xs_lookup_init.
+typedef struct
+{
+  uint16_t* Table;      //!< XS_LOOKUP_SIZE(quantity) entries: displacement of each bucket followed by index of entry in each slot.
+  uint32_t Quantity;    //!< Number of entries in the lookup. 0 if not built, then entries are matched linearly.
+  uint32_t Required;    //!< Number of attributes that are not optional. Applicable to lookup of attributes.
+}xs_lookup_t;
+#endif // XML_PARSER_LOOKUP
+
 //!< structure for enumeration facet
 typedef struct
 {
 	const void *const List;   //!< Pointer to array of enumerations
 	uint32_t Quantity;        //!< Quantity of enumeration values
+#if XML_PARSER_LOOKUP
+	xs_lookup_t* Lookup;      //!< Perfect hash of enumerations (EN_ENUM_STRING and EN_ENUM_UINT). NULL to match them linearly.
+#endif // XML_PARSER_LOOKUP
 }enum_facet_t;
 
 //! Union holding all the restriction or facets
@@ -172,11 +190,42 @@ typedef struct
   facet_t Facet;            //!< Facet of XML content
 }xml_content_t;
 
+//! Block of memory of arena
+typedef struct xml_arena_block_t xml_arena_block_t;
+
+//! Arena to allocate the content of EN_STRING_DYNAMIC type from large blocks instead of malloc per string.
+//! All the strings allocated from arena are released at once by \ref xml_arena_reset.
+typedef struct
+{
+  xml_arena_block_t* Block;   //!< Current block, linked to the previous blocks. NULL if nothing is allocated.
+  xml_arena_block_t* Large;   //!< Blocks of allocations larger than block size, linked to each other. NULL if none.
+  size_t Used;                //!< Number of bytes used in the current block
+  size_t Block_Size;          //!< Size of block to allocate
+}xml_arena_t;
+
+//! Allocator of memory used by the parser, passed per parse (e.g. pool of a thread or memory of a NUMA node).
+//! Parser allocates the content of EN_STRING_DYNAMIC type, the array of EN_VECTOR type and the target of EN_DYNAMIC type without
+//! Allocate callback from it. NULL allocator stands for malloc, realloc and free.
+typedef struct
+{
+  //! Allocates the memory of given size. Returns NULL on failure.
+  void* (*Alloc)(void* state, size_t size);
+
+  //! Resizes the memory from old size to new size, keeping its content. Memory is NULL if old size is 0.
+  //! Returns NULL on failure, then memory is not freed.
+  void* (*Realloc)(void* state, void* memory, size_t old_size, size_t size);
+
+  //! Frees the memory of given size.
+  void (*Free)(void* state, void* memory, size_t size);
+
+  void* State;    //!< User defined state passed to the functions.
+}xml_allocator_t;
+
 /*
  *  ---------------------------- EXPORTED FUNCTION ----------------------------
  */
 
-/** \brief Extract the content of element or attribute
+/** \brief Extract the content of element or attribute. Content of EN_STRING_DYNAMIC type is allocated using malloc.
  *
  * \param content const xml_content_t*const : pointer to XML content type
  * \param target void* : Target address to store the extracted content
@@ -189,4 +238,60 @@ extern xml_parse_result_t extract_content(const xml_content_t* const content,
                                           void* target, const char* source,
                                           size_t length);
 
+/** \brief Extract the content of element or attribute, allocating the content of EN_STRING_DYNAMIC type from the allocator.
+ *
+ * \param content const xml_content_t*const : pointer to XML content type
+ * \param target void* : Target address to store the extracted content
+ * \param source const char* : Source XML content to extract
+ * \param length size_t : Length of XML content
+ * \param allocator const xml_allocator_t* : Allocator of EN_STRING_DYNAMIC content. NULL to allocate it using malloc.
+ * \return extern xml_parse_result_t : result of content extraction.
+ *
+ */
+extern xml_parse_result_t extract_content_allocator(const xml_content_t* const content,
+                                                    void* target, const char* source,
+                                                    size_t length, const xml_allocator_t* allocator);
+
+/** \brief Initialize the arena. Memory is allocated on the first allocation.
+ *
+ * \param arena xml_arena_t* const : Arena to initialize.
+ * \param block_size size_t : Size of block allocated using malloc. Larger allocation gets its own block,
+ *                            that doesn't replace the current block.
+ *
+ */
+extern void xml_arena_init(xml_arena_t* const arena, size_t block_size);
+
+/** \brief Allocates the memory from the arena, aligned to 8 bytes.
+ *
+ * \param arena xml_arena_t* const : Arena to allocate from.
+ * \param size size_t : Size of memory.
+ * \return void* : Allocated memory. NULL if failed to allocate the block.
+ *
+ */
+extern void* xml_arena_alloc(xml_arena_t* const arena, size_t size);
+
+/** \brief Releases all the memory allocated from the arena at once.
+ * First block (of block size) is kept to reuse it for the next document.
+ *
+ * \param arena xml_arena_t* const : Arena to reset.
+ *
+ */
+extern void xml_arena_reset(xml_arena_t* const arena);
+
+/** \brief Frees all the blocks of the arena.
+ *
+ * \param arena xml_arena_t* const : Arena to free.
+ *
+ */
+extern void xml_arena_free(xml_arena_t* const arena);
+
+/** \brief Returns the allocator that allocates from the arena. Its Free doesn't release the memory,
+ * it is released by \ref xml_arena_reset. Realloc resizes the last allocation in place.
+ *
+ * \param arena xml_arena_t* const : Arena initialized by \ref xml_arena_init.
+ * \return xml_allocator_t : allocator of arena.
+ *
+ */
+extern xml_allocator_t xml_arena_allocator(xml_arena_t* const arena);
+
 #endif // XML_CONTENT_H
@@ -0,0 +1,926 @@
+#ifndef XML_SCAN_H
+#define XML_SCAN_H
+
+/**
+ * \file
+ * \brief Internal scanning kernels of XML parser.
+ *        Kernels classify 32 (AVX2), 16 (SSE2/SSSE3) or 8 (SWAR) bytes of XML source per step.
+ *        Scalar kernels are the portable fallback and also handle the tail of source.
+
+ * \author  Nandkishor Biradar
+ * \date    16 October 2026
+
+ *  Copyright (c) 2019-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  ------------------------------ INCLUDE FILES ------------------------------
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parse_xml.h"
+
+/*
+ *  ------------------------------- DEFINITION -------------------------------
+ */
+
+// Run time dispatch compiles all the x86-64 kernels with target attribute and selects them by cpuid.
+#if XML_PARSER_SIMD && XML_PARSER_CPU_DISPATCH && defined(__GNUC__) && defined(__x86_64__)
+  #define XML_SCAN_DISPATCH 1
+  #define SCAN_TARGET_AVX2  __attribute__((target("avx2")))
+  #define SCAN_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+  #define XML_SCAN_DISPATCH 0
+  #define SCAN_TARGET_AVX2
+  #define SCAN_TARGET_SSSE3
+#endif
+
+#if XML_PARSER_SIMD && (defined(__AVX2__) || XML_SCAN_DISPATCH)
+  #define XML_SCAN_AVX2 1
+  #include <immintrin.h>
+#else
+  #define XML_SCAN_AVX2 0
+#endif
+
+#if XML_PARSER_SIMD && (defined(__SSSE3__) || defined(__AVX2__) || XML_SCAN_DISPATCH)
+  #define XML_SCAN_SSSE3 1
+  #include <tmmintrin.h>
+#else
+  #define XML_SCAN_SSSE3 0
+#endif
+
+#if XML_PARSER_SIMD && (defined(__SSE2__) || defined(_M_X64))
+  #define XML_SCAN_SSE2 1
+  #include <emmintrin.h>
+#else
+  #define XML_SCAN_SSE2 0
+#endif
+
+#if XML_PARSER_SIMD && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  #define XML_SCAN_SWAR 1
+#else
+  #define XML_SCAN_SWAR 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+#endif
+
+//! Repeats the byte in all the bytes of 64-bit word.
+#define SWAR_BYTE(byte)  (0x0101010101010101ULL * (uint8_t)(byte))
+
+/*
+ *  -------------------------------- STRUCTURE --------------------------------
+ */
+
+//! Character class to scan for.
+//! A byte belongs to the class if (Low[byte & 0x0F] & High[byte >> 4]) is non zero.
+//! Each bit of the tables stands for a group of class members sharing the same high nibble.
+typedef struct
+{
+  uint8_t Low[16];    //!< Groups of each low nibble
+  uint8_t High[16];   //!< Group of each high nibble
+  char Member[8];     //!< Members of class, used by kernels without byte shuffle (SSE2).
+  uint32_t Quantity;  //!< Number of members
+}scan_class_t;
+
+#if XML_SCAN_DISPATCH
+//! Set of scanning kernels of an instruction set, selected at run time.
+typedef struct
+{
+  const char* Name;   //!< Name of instruction set, as accepted by XML_PARSER_KERNEL environment variable.
+  const char* (*Skip_Whitespace)(const char* source, const char* const end);
+  const char* (*Scan_Class)(const char* source, const char* const end, const scan_class_t* const set);
+  const char* (*Scan_Text)(const char* source, const char* const end, char delimiter, uint32_t* const property);
+  size_t (*Index_Class)(const char* source, const char* const end, const scan_class_t* const set,
+                        uint32_t* const position, size_t capacity);
+}scan_kernel_t;
+#endif // XML_SCAN_DISPATCH
+
+/*
+ *  ------------------------------- VARIABLES --------------------------------
+ */
+
+#if XML_SCAN_DISPATCH
+//! Kernels in use. Defined by parser, initially resolving the kernels on first call.
+//! Threads read and select it atomically, see \ref scan_get_kernel.
+static const scan_kernel_t* xml_scan_kernel;
+
+/** \brief Returns the kernels in use. Pointer is loaded atomically, as another thread may select the kernels.
+ *
+ * \return const scan_kernel_t* : Kernels in use.
+ */
+static inline const scan_kernel_t* scan_get_kernel(void)
+{
+  return __atomic_load_n(&xml_scan_kernel, __ATOMIC_ACQUIRE);
+}
+#endif // XML_SCAN_DISPATCH
+
+//! End of element name: whitespace, '>', '/' and NUL.
+//! Groups: bit 0 = 0x0_ (NUL, '\t', '\n', '\r'), bit 1 = 0x2_ (' ', '/'), bit 2 = 0x3_ ('>').
+static const scan_class_t ELEMENT_NAME_END =
+{
+  .Low  = {[0x0] = 0x03, [0x9] = 0x01, [0xA] = 0x01, [0xD] = 0x01, [0xE] = 0x04, [0xF] = 0x02},
+  .High = {[0x0] = 0x01, [0x2] = 0x02, [0x3] = 0x04},
+  .Member = {' ', '\t', '\n', '\r', '>', '/', '\0'},
+  .Quantity = 7,
+};
+
+//! End of attribute name: whitespace, '=' and NUL.
+//! Groups: bit 0 = 0x0_ (NUL, '\t', '\n', '\r'), bit 1 = 0x2_ (' '), bit 2 = 0x3_ ('=').
+static const scan_class_t ATTRIBUTE_NAME_END =
+{
+  .Low  = {[0x0] = 0x03, [0x9] = 0x01, [0xA] = 0x01, [0xD] = 0x05},
+  .High = {[0x0] = 0x01, [0x2] = 0x02, [0x3] = 0x04},
+  .Member = {' ', '\t', '\n', '\r', '=', '\0'},
+  .Quantity = 6,
+};
+
+//! Structural chars of XML indexed by stage 1: '<', '>', '/', '=', '"', '?' and '!'.
+//! Groups: bit 0 = 0x2_ ('!', '"', '/'), bit 1 = 0x3_ ('<', '=', '>', '?').
+static const scan_class_t STRUCTURAL_CHAR =
+{
+  .Low  = {[0x1] = 0x01, [0x2] = 0x01, [0xC] = 0x02, [0xD] = 0x02, [0xE] = 0x02, [0xF] = 0x03},
+  .High = {[0x2] = 0x01, [0x3] = 0x02},
+  .Member = {'<', '>', '/', '=', '"', '?', '!'},
+  .Quantity = 7,
+};
+
+//! Chars of DOCTYPE declaration that affect finding its end: quotes, '<', '>', '[' and ']'.
+//! Groups: bit 0 = 0x2_ ('"', '\''), bit 1 = 0x3_ ('<', '>'), bit 2 = 0x5_ ('[', ']').
+static const scan_class_t DOCTYPE_CHAR =
+{
+  .Low  = {[0x2] = 0x01, [0x7] = 0x01, [0xB] = 0x04, [0xC] = 0x02, [0xD] = 0x04, [0xE] = 0x02},
+  .High = {[0x2] = 0x01, [0x3] = 0x02, [0x5] = 0x04},
+  .Member = {'"', '\'', '<', '>', '[', ']'},
+  .Quantity = 6,
+};
+
+/*
+ *  ------------------------------ FUNCTION BODY ------------------------------
+ */
+
+/** \brief Index of the least significant set bit.
+ *
+ * \param mask uint64_t : Non zero bit mask.
+ * \return uint32_t : Index of the least significant set bit.
+ */
+static inline uint32_t scan_first_bit(uint64_t mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return index;
+#else
+  return (uint32_t)__builtin_ctzll(mask);
+#endif
+}
+
+/** \brief Skips the whitespace chars byte by byte. Portable fallback of whitespace kernels.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \return const char* : Address of first non-whitespace char or NULL on end of source.
+ */
+static inline const char* skip_whitespace_scalar(const char* source, const char* const end)
+{
+  while(source < end)
+  {
+    switch(*source)
+    {
+    case '\r':
+    case '\n':
+    case '\t':
+    case ' ':
+      source++;
+      break;
+
+    default:
+      return source;
+    }
+  }
+  return NULL;
+}
+
+#if XML_SCAN_SWAR
+/** \brief Returns the high bit of each byte of word that is equal to given byte.
+ *  It is exact (no false positive on carry) unlike the usual "has zero byte" test.
+ *
+ * \param word uint64_t : 8 bytes of source
+ * \param byte uint8_t : byte to compare
+ * \return uint64_t : high bit is set in each matching byte
+ */
+static inline uint64_t swar_equal(uint64_t word, uint8_t byte)
+{
+  const uint64_t low7 = SWAR_BYTE(0x7F);
+  const uint64_t value = word ^ SWAR_BYTE(byte);
+  return ~(((value & low7) + low7) | value | low7);
+}
+
+/** \brief Skips the whitespace chars 8 bytes per step using 64-bit integer operations.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \return const char* : Address of first non-whitespace char or NULL on end of source.
+ */
+static inline const char* skip_whitespace_swar(const char* source, const char* const end)
+{
+  while(end - source >= 8)
+  {
+    uint64_t word;
+    memcpy(&word, source, sizeof(word));
+    const uint64_t space = swar_equal(word, ' ') | swar_equal(word, '\t') |
+                           swar_equal(word, '\n') | swar_equal(word, '\r');
+    const uint64_t text = ~space & SWAR_BYTE(0x80);
+    if(text)
+    {
+      return source + (scan_first_bit(text) >> 3);
+    }
+    source += 8;
+  }
+  return skip_whitespace_scalar(source, end);
+}
+#endif // XML_SCAN_SWAR
+
+#if XML_SCAN_SSE2
+/** \brief Returns the bit mask of whitespace chars in 16 bytes of source.
+ *
+ * \param source const char* : XML source. At least 16 bytes must be readable.
+ * \return uint32_t : bit is set for each whitespace char.
+ */
+static inline uint32_t whitespace_mask_sse2(const char* source)
+{
+  const __m128i block = _mm_loadu_si128((const __m128i*)source);
+  const __m128i space = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+                                                  _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+                                     _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')),
+                                                  _mm_cmpeq_epi8(block, _mm_set1_epi8('\r'))));
+  return (uint32_t)_mm_movemask_epi8(space);
+}
+
+/** \brief Skips the whitespace chars 16 bytes per step using SSE2.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \return const char* : Address of first non-whitespace char or NULL on end of source.
+ */
+static inline const char* skip_whitespace_sse2(const char* source, const char* const end)
+{
+  while(end - source >= 16)
+  {
+    const uint32_t text = ~whitespace_mask_sse2(source) & 0xFFFF;
+    if(text)
+    {
+      return source + scan_first_bit(text);
+    }
+    source += 16;
+  }
+  return skip_whitespace_scalar(source, end);
+}
+#endif // XML_SCAN_SSE2
+
+#if XML_SCAN_AVX2
+/** \brief Skips the whitespace chars 32 bytes per step using AVX2.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \return const char* : Address of first non-whitespace char or NULL on end of source.
+ */
+SCAN_TARGET_AVX2 static inline const char* skip_whitespace_avx2(const char* source, const char* const end)
+{
+  while(end - source >= 32)
+  {
+    const __m256i block = _mm256_loadu_si256((const __m256i*)source);
+    const __m256i space = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')),
+                                                          _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'))),
+                                          _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')),
+                                                          _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r'))));
+    const uint32_t text = ~(uint32_t)_mm256_movemask_epi8(space);
+    if(text)
+    {
+      return source + scan_first_bit(text);
+    }
+    source += 32;
+  }
+  return skip_whitespace_sse2(source, end);
+}
+#endif // XML_SCAN_AVX2
+
+/** \brief Skips the whitespace chars with the widest kernel enabled at compile time or selected at run time.
+ *  First char is checked before entering the kernel, as most of the calls are at non-whitespace char.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \return const char* : Address of first non-whitespace char or NULL on end of source.
+ */
+static inline const char* scan_whitespace(const char* source, const char* const end)
+{
+  if((source < end) && (*source != ' ') && (*source != '\n') && (*source != '\t') && (*source != '\r'))
+  {
+    return source;
+  }
+#if XML_SCAN_DISPATCH
+  return scan_get_kernel()->Skip_Whitespace(source, end);
+#elif XML_SCAN_AVX2
+  return skip_whitespace_avx2(source, end);
+#elif XML_SCAN_SSE2
+  return skip_whitespace_sse2(source, end);
+#elif XML_SCAN_SWAR
+  return skip_whitespace_swar(source, end);
+#else
+  return skip_whitespace_scalar(source, end);
+#endif
+}
+
+/** \brief Checks whether the byte belongs to the character class.
+ *
+ * \param byte char : byte of XML source
+ * \param set const scan_class_t* const : Character class
+ * \return bool : true if byte is member of class.
+ */
+static inline bool scan_class_member(char byte, const scan_class_t* const set)
+{
+  return (set->Low[(uint8_t)byte & 0x0F] & set->High[(uint8_t)byte >> 4]) != 0;
+}
+
+/** \brief Finds the first byte of character class using table lookup. Portable fallback of class kernels.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : Character class to find
+ * \return const char* : Address of first byte of class or NULL on end of source.
+ */
+static inline const char* scan_class_scalar(const char* source, const char* const end,
+                                            const scan_class_t* const set)
+{
+  while(source < end)
+  {
+    const uint8_t byte = (uint8_t)*source;
+    if(set->Low[byte & 0x0F] & set->High[byte >> 4])
+    {
+      return source;
+    }
+    source++;
+  }
+  return NULL;
+}
+
+#if XML_SCAN_SSE2
+/** \brief Finds the first byte of character class 16 bytes per step, comparing each member using SSE2.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : Character class to find
+ * \return const char* : Address of first byte of class or NULL on end of source.
+ */
+static inline const char* scan_class_sse2(const char* source, const char* const end,
+                                          const scan_class_t* const set)
+{
+  while(end - source >= 16)
+  {
+    const __m128i block = _mm_loadu_si128((const __m128i*)source);
+    __m128i match = _mm_setzero_si128();
+    for(uint32_t i = 0; i < set->Quantity; i++)
+    {
+      match = _mm_or_si128(match, _mm_cmpeq_epi8(block, _mm_set1_epi8(set->Member[i])));
+    }
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(match);
+    if(mask)
+    {
+      return source + scan_first_bit(mask);
+    }
+    source += 16;
+  }
+  return scan_class_scalar(source, end, set);
+}
+#endif // XML_SCAN_SSE2
+
+#if XML_SCAN_SSSE3
+/** \brief Finds the first byte of character class 16 bytes per step using nibble lookup (pshufb).
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : Character class to find
+ * \return const char* : Address of first byte of class or NULL on end of source.
+ */
+SCAN_TARGET_SSSE3 static inline const char* scan_class_ssse3(const char* source, const char* const end,
+                                           const scan_class_t* const set)
+{
+  const __m128i low    = _mm_loadu_si128((const __m128i*)set->Low);
+  const __m128i high   = _mm_loadu_si128((const __m128i*)set->High);
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  while(end - source >= 16)
+  {
+    const __m128i block = _mm_loadu_si128((const __m128i*)source);
+    const __m128i group = _mm_and_si128(_mm_shuffle_epi8(low, _mm_and_si128(block, nibble)),
+                                        _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(block, 4), nibble)));
+    const uint32_t mask = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_setzero_si128())) & 0xFFFF;
+    if(mask)
+    {
+      return source + scan_first_bit(mask);
+    }
+    source += 16;
+  }
+  return scan_class_scalar(source, end, set);
+}
+#endif // XML_SCAN_SSSE3
+
+#if XML_SCAN_AVX2
+/** \brief Finds the first byte of character class 32 bytes per step using nibble lookup (vpshufb).
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : Character class to find
+ * \return const char* : Address of first byte of class or NULL on end of source.
+ */
+SCAN_TARGET_AVX2 static inline const char* scan_class_avx2(const char* source, const char* const end,
+                                          const scan_class_t* const set)
+{
+  const __m256i low    = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->Low));
+  const __m256i high   = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->High));
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  while(end - source >= 32)
+  {
+    const __m256i block = _mm256_loadu_si256((const __m256i*)source);
+    const __m256i group = _mm256_and_si256(_mm256_shuffle_epi8(low, _mm256_and_si256(block, nibble)),
+                                           _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble)));
+    const uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(group, _mm256_setzero_si256()));
+    if(mask)
+    {
+      return source + scan_first_bit(mask);
+    }
+    source += 32;
+  }
+  return scan_class_ssse3(source, end, set);
+}
+#endif // XML_SCAN_AVX2
+
+/** \brief Finds the first byte of character class with the widest kernel enabled at compile time or selected at run time.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : Character class to find
+ * \return const char* : Address of first byte of class or NULL on end of source.
+ */
+static inline const char* scan_class(const char* source, const char* const end,
+                                     const scan_class_t* const set)
+{
+#if XML_SCAN_DISPATCH
+  return scan_get_kernel()->Scan_Class(source, end, set);
+#elif XML_SCAN_AVX2
+  return scan_class_avx2(source, end, set);
+#elif XML_SCAN_SSSE3
+  return scan_class_ssse3(source, end, set);
+#elif XML_SCAN_SSE2
+  return scan_class_sse2(source, end, set);
+#else
+  return scan_class_scalar(source, end, set);
+#endif
+}
+
+/** \brief Returns the properties (xml_text_property_t) of a byte of text.
+ *
+ * \param byte uint8_t : byte of text
+ * \return uint32_t : properties of byte
+ */
+static inline uint32_t text_property(uint8_t byte)
+{
+  switch(byte)
+  {
+  case '&':
+    return EN_TEXT_ENTITY;
+
+  case '\r':
+    return EN_TEXT_CARRIAGE_RETURN;
+
+  default:
+    return (byte & 0x80) ? EN_TEXT_NON_ASCII : 0;
+  }
+}
+
+/** \brief Finds the delimiter of text byte by byte, collecting the properties of text before it.
+ *  Portable fallback of text kernels.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param delimiter char : End of text ('<' for content, '"' for attribute value)
+ * \param property uint32_t* const : Properties (xml_text_property_t) of text are added to it.
+ * \return const char* : Address of delimiter or NULL on end of source.
+ */
+static inline const char* scan_text_scalar(const char* source, const char* const end,
+                                           char delimiter, uint32_t* const property)
+{
+  uint32_t text = 0;
+  while(source < end)
+  {
+    if(*source == delimiter)
+    {
+      *property |= text;
+      return source;
+    }
+    text |= text_property((uint8_t)*source++);
+  }
+  *property |= text;
+  return NULL;
+}
+
+/** \brief Converts the bit masks of a block of text to properties, ignoring the bytes at and after first delimiter.
+ *
+ * \param delimiter uint64_t : Bit mask of delimiters
+ * \param entity uint64_t : Bit mask of '&'
+ * \param carriage_return uint64_t : Bit mask of '\r'
+ * \param non_ascii uint64_t : Bit mask of bytes above 0x7F
+ * \return uint32_t : properties of text before the first delimiter
+ */
+static inline uint32_t text_block_property(uint64_t delimiter, uint64_t entity,
+                                           uint64_t carriage_return, uint64_t non_ascii)
+{
+  // Bits below the lowest set bit of delimiter. All bits if there is no delimiter.
+  const uint64_t text = (delimiter & (~delimiter + 1)) - 1;
+  return ((entity & text) ? EN_TEXT_ENTITY : 0) |
+         ((carriage_return & text) ? EN_TEXT_CARRIAGE_RETURN : 0) |
+         ((non_ascii & text) ? EN_TEXT_NON_ASCII : 0);
+}
+
+#if XML_SCAN_SWAR
+/** \brief Finds the delimiter of text 8 bytes per step using 64-bit integer operations.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param delimiter char : End of text ('<' for content, '"' for attribute value)
+ * \param property uint32_t* const : Properties (xml_text_property_t) of text are added to it.
+ * \return const char* : Address of delimiter or NULL on end of source.
+ */
+static inline const char* scan_text_swar(const char* source, const char* const end,
+                                         char delimiter, uint32_t* const property)
+{
+  while(end - source >= 8)
+  {
+    uint64_t word;
+    memcpy(&word, source, sizeof(word));
+    const uint64_t match = swar_equal(word, (uint8_t)delimiter);
+    *property |= text_block_property(match, swar_equal(word, '&'), swar_equal(word, '\r'),
+                                     word & SWAR_BYTE(0x80));
+    if(match)
+    {
+      return source + (scan_first_bit(match) >> 3);
+    }
+    source += 8;
+  }
+  return scan_text_scalar(source, end, delimiter, property);
+}
+#endif // XML_SCAN_SWAR
+
+#if XML_SCAN_SSE2
+/** \brief Finds the delimiter of text 16 bytes per step using SSE2.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param delimiter char : End of text ('<' for content, '"' for attribute value)
+ * \param property uint32_t* const : Properties (xml_text_property_t) of text are added to it.
+ * \return const char* : Address of delimiter or NULL on end of source.
+ */
+static inline const char* scan_text_sse2(const char* source, const char* const end,
+                                         char delimiter, uint32_t* const property)
+{
+  const __m128i stop            = _mm_set1_epi8(delimiter);
+  const __m128i entity          = _mm_set1_epi8('&');
+  const __m128i carriage_return = _mm_set1_epi8('\r');
+  while(end - source >= 16)
+  {
+    const __m128i block = _mm_loadu_si128((const __m128i*)source);
+    const uint32_t match = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, stop));
+    *property |= text_block_property(match, (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, entity)),
+                                     (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, carriage_return)),
+                                     (uint32_t)_mm_movemask_epi8(block));
+    if(match)
+    {
+      return source + scan_first_bit(match);
+    }
+    source += 16;
+  }
+  return scan_text_scalar(source, end, delimiter, property);
+}
+#endif // XML_SCAN_SSE2
+
+#if XML_SCAN_AVX2
+/** \brief Finds the delimiter of text 32 bytes per step using AVX2.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param delimiter char : End of text ('<' for content, '"' for attribute value)
+ * \param property uint32_t* const : Properties (xml_text_property_t) of text are added to it.
+ * \return const char* : Address of delimiter or NULL on end of source.
+ */
+SCAN_TARGET_AVX2 static inline const char* scan_text_avx2(const char* source, const char* const end,
+                                         char delimiter, uint32_t* const property)
+{
+  const __m256i stop            = _mm256_set1_epi8(delimiter);
+  const __m256i entity          = _mm256_set1_epi8('&');
+  const __m256i carriage_return = _mm256_set1_epi8('\r');
+  while(end - source >= 32)
+  {
+    const __m256i block = _mm256_loadu_si256((const __m256i*)source);
+    const uint32_t match = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, stop));
+    *property |= text_block_property(match, (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, entity)),
+                                     (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, carriage_return)),
+                                     (uint32_t)_mm256_movemask_epi8(block));
+    if(match)
+    {
+      return source + scan_first_bit(match);
+    }
+    source += 32;
+  }
+  return scan_text_sse2(source, end, delimiter, property);
+}
+#endif // XML_SCAN_AVX2
+
+/** \brief Finds the delimiter of text with the widest kernel enabled at compile time or selected at run time,
+ *  collecting the properties of text before it.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param delimiter char : End of text ('<' for content, '"' for attribute value)
+ * \param property uint32_t* const : Properties (xml_text_property_t) of text are added to it.
+ * \return const char* : Address of delimiter or NULL on end of source.
+ */
+static inline const char* scan_text(const char* source, const char* const end,
+                                    char delimiter, uint32_t* const property)
+{
+#if XML_SCAN_DISPATCH
+  return scan_get_kernel()->Scan_Text(source, end, delimiter, property);
+#elif XML_SCAN_AVX2
+  return scan_text_avx2(source, end, delimiter, property);
+#elif XML_SCAN_SSE2
+  return scan_text_sse2(source, end, delimiter, property);
+#elif XML_SCAN_SWAR
+  return scan_text_swar(source, end, delimiter, property);
+#else
+  return scan_text_scalar(source, end, delimiter, property);
+#endif
+}
+
+/** \brief Returns the bit mask of bytes of character class in 64 bytes of source, byte by byte.
+ *
+ * \param source const char* : XML source. At least 64 bytes must be readable.
+ * \param set const scan_class_t* const : Character class
+ * \return uint64_t : bit is set for each byte of class.
+ */
+static inline uint64_t class_mask64_scalar(const char* source, const scan_class_t* const set)
+{
+  uint64_t mask = 0;
+  for(uint32_t i = 0; i < 64; i++)
+  {
+    const uint8_t byte = (uint8_t)source[i];
+    mask |= (uint64_t)((set->Low[byte & 0x0F] & set->High[byte >> 4]) != 0) << i;
+  }
+  return mask;
+}
+
+#if XML_SCAN_SSE2
+/** \brief Returns the bit mask of bytes of character class in 64 bytes of source, comparing each member using SSE2.
+ *
+ * \param source const char* : XML source. At least 64 bytes must be readable.
+ * \param set const scan_class_t* const : Character class
+ * \return uint64_t : bit is set for each byte of class.
+ */
+static inline uint64_t class_mask64_sse2(const char* source, const scan_class_t* const set)
+{
+  uint64_t mask = 0;
+  for(uint32_t i = 0; i < 64; i += 16)
+  {
+    const __m128i block = _mm_loadu_si128((const __m128i*)&source[i]);
+    __m128i match = _mm_setzero_si128();
+    for(uint32_t j = 0; j < set->Quantity; j++)
+    {
+      match = _mm_or_si128(match, _mm_cmpeq_epi8(block, _mm_set1_epi8(set->Member[j])));
+    }
+    mask |= (uint64_t)_mm_movemask_epi8(match) << i;
+  }
+  return mask;
+}
+#endif // XML_SCAN_SSE2
+
+#if XML_SCAN_SSSE3
+/** \brief Returns the bit mask of bytes of character class in 64 bytes of source using nibble lookup (pshufb).
+ *
+ * \param source const char* : XML source. At least 64 bytes must be readable.
+ * \param set const scan_class_t* const : Character class
+ * \return uint64_t : bit is set for each byte of class.
+ */
+SCAN_TARGET_SSSE3 static inline uint64_t class_mask64_ssse3(const char* source, const scan_class_t* const set)
+{
+  uint64_t mask = 0;
+  const __m128i low    = _mm_loadu_si128((const __m128i*)set->Low);
+  const __m128i high   = _mm_loadu_si128((const __m128i*)set->High);
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  for(uint32_t i = 0; i < 64; i += 16)
+  {
+    const __m128i block = _mm_loadu_si128((const __m128i*)&source[i]);
+    const __m128i group = _mm_and_si128(_mm_shuffle_epi8(low, _mm_and_si128(block, nibble)),
+                                        _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(block, 4), nibble)));
+    mask |= (uint64_t)(~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_setzero_si128())) & 0xFFFF) << i;
+  }
+  return mask;
+}
+#endif // XML_SCAN_SSSE3
+
+#if XML_SCAN_AVX2
+/** \brief Returns the bit mask of bytes of character class in 64 bytes of source using nibble lookup (vpshufb).
+ *
+ * \param source const char* : XML source. At least 64 bytes must be readable.
+ * \param set const scan_class_t* const : Character class
+ * \return uint64_t : bit is set for each byte of class.
+ */
+SCAN_TARGET_AVX2 static inline uint64_t class_mask64_avx2(const char* source, const scan_class_t* const set)
+{
+  uint64_t mask = 0;
+  const __m256i low    = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->Low));
+  const __m256i high   = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->High));
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  for(uint32_t i = 0; i < 64; i += 32)
+  {
+    const __m256i block = _mm256_loadu_si256((const __m256i*)&source[i]);
+    const __m256i group = _mm256_and_si256(_mm256_shuffle_epi8(low, _mm256_and_si256(block, nibble)),
+                                           _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble)));
+    mask |= (uint64_t)(~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(group, _mm256_setzero_si256()))) << i;
+  }
+  return mask;
+}
+#endif // XML_SCAN_AVX2
+
+/** \brief Stores the offsets of all the bytes of character class in the source, 64 bytes per step.
+ *  Callers pass a constant class_mask64 kernel, so that it is inlined into each instruction set variant.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : Character class
+ * \param position uint32_t* const : Array to store the offsets
+ * \param capacity size_t : Size of array
+ * \param class_mask64 uint64_t (*)(const char*, const scan_class_t* const) : Kernel returning the bit mask of bytes of class in 64 bytes.
+ * \return size_t : Number of offsets stored or SIZE_MAX if array is too small.
+ */
+static inline size_t index_class_with(const char* source, const char* const end,
+                                      const scan_class_t* const set,
+                                      uint32_t* const position, size_t capacity,
+                                      uint64_t (*class_mask64)(const char*, const scan_class_t* const))
+{
+  const char* const start = source;
+  size_t count = 0;
+  while(end - source >= 64)
+  {
+    uint64_t mask = class_mask64(source, set);
+    const uint32_t offset = (uint32_t)(source - start);
+    while(mask)
+    {
+      if(count == capacity)
+      {
+        return SIZE_MAX;
+      }
+      position[count++] = offset + scan_first_bit(mask);
+      mask &= mask - 1;
+    }
+    source += 64;
+  }
+
+  while((source = scan_class_scalar(source, end, set)) != NULL)
+  {
+    if(count == capacity)
+    {
+      return SIZE_MAX;
+    }
+    position[count++] = (uint32_t)(source++ - start);
+  }
+  return count;
+}
+
+/** \brief Stores the offsets of all the bytes of character class in the source using scalar kernel.
+ *  Arguments and return value are same as \ref index_class_with.
+ */
+static inline size_t index_class_scalar(const char* source, const char* const end, const scan_class_t* const set,
+                                        uint32_t* const position, size_t capacity)
+{
+  return index_class_with(source, end, set, position, capacity, class_mask64_scalar);
+}
+
+#if XML_SCAN_SSE2
+/** \brief Stores the offsets of all the bytes of character class in the source using SSE2 kernel.
+ *  Arguments and return value are same as \ref index_class_with.
+ */
+static inline size_t index_class_sse2(const char* source, const char* const end, const scan_class_t* const set,
+                                      uint32_t* const position, size_t capacity)
+{
+  return index_class_with(source, end, set, position, capacity, class_mask64_sse2);
+}
+#endif // XML_SCAN_SSE2
+
+#if XML_SCAN_SSSE3
+/** \brief Stores the offsets of all the bytes of character class in the source using SSSE3 kernel.
+ *  Arguments and return value are same as \ref index_class_with.
+ */
+SCAN_TARGET_SSSE3 static inline size_t index_class_ssse3(const char* source, const char* const end,
+                                                         const scan_class_t* const set,
+                                                         uint32_t* const position, size_t capacity)
+{
+  return index_class_with(source, end, set, position, capacity, class_mask64_ssse3);
+}
+#endif // XML_SCAN_SSSE3
+
+#if XML_SCAN_AVX2
+/** \brief Stores the offsets of all the bytes of character class in the source using AVX2 kernel.
+ *  Arguments and return value are same as \ref index_class_with.
+ */
+SCAN_TARGET_AVX2 static inline size_t index_class_avx2(const char* source, const char* const end,
+                                                       const scan_class_t* const set,
+                                                       uint32_t* const position, size_t capacity)
+{
+  return index_class_with(source, end, set, position, capacity, class_mask64_avx2);
+}
+#endif // XML_SCAN_AVX2
+
+/** \brief Stores the offsets of all the bytes of character class in the source,
+ *  with the widest kernel enabled at compile time or selected at run time.
+ *
+ * \param source const char* : XML source
+ * \param end const char* const : End of source
+ * \param set const scan_class_t* const : Character class
+ * \param position uint32_t* const : Array to store the offsets
+ * \param capacity size_t : Size of array
+ * \return size_t : Number of offsets stored or SIZE_MAX if array is too small.
+ */
+static inline size_t index_class(const char* source, const char* const end,
+                                 const scan_class_t* const set,
+                                 uint32_t* const position, size_t capacity)
+{
+#if XML_SCAN_DISPATCH
+  return scan_get_kernel()->Index_Class(source, end, set, position, capacity);
+#elif XML_SCAN_AVX2
+  return index_class_avx2(source, end, set, position, capacity);
+#elif XML_SCAN_SSSE3
+  return index_class_ssse3(source, end, set, position, capacity);
+#elif XML_SCAN_SSE2
+  return index_class_sse2(source, end, set, position, capacity);
+#else
+  return index_class_scalar(source, end, set, position, capacity);
+#endif
+}
+
+#if XML_SCAN_DISPATCH
+/** \brief Selects the widest kernels supported by the CPU,
+ *  limited by the kernel named in XML_PARSER_KERNEL environment variable.
+ *
+ * \return const scan_kernel_t* : Selected kernels.
+ */
+static inline const scan_kernel_t* scan_select_kernel(void)
+{
+  // In the order of width, each instruction set is a superset of previous one.
+  static const scan_kernel_t KERNEL[] =
+  {
+    {"scalar", skip_whitespace_scalar, scan_class_scalar, scan_text_scalar, index_class_scalar},
+    {"sse2",   skip_whitespace_sse2,   scan_class_sse2,   scan_text_sse2,   index_class_sse2},
+    {"ssse3",  skip_whitespace_sse2,   scan_class_ssse3,  scan_text_sse2,   index_class_ssse3},
+    {"avx2",   skip_whitespace_avx2,   scan_class_avx2,   scan_text_avx2,   index_class_avx2},
+  };
+
+  __builtin_cpu_init();
+  size_t count = __builtin_cpu_supports("avx2") ? 4 : __builtin_cpu_supports("ssse3") ? 3 : 2;
+
+  const char* const limit = getenv("XML_PARSER_KERNEL");
+  if(limit != NULL)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      if(strcmp(limit, KERNEL[i].Name) == 0)
+      {
+        count = i + 1;
+        break;
+      }
+    }
+  }
+  return &KERNEL[count - 1];
+}
+#else
+//! Name of kernels enabled at compile time.
+#if XML_SCAN_AVX2
+  #define SCAN_KERNEL_NAME "avx2"
+#elif XML_SCAN_SSSE3
+  #define SCAN_KERNEL_NAME "ssse3"
+#elif XML_SCAN_SSE2
+  #define SCAN_KERNEL_NAME "sse2"
+#elif XML_SCAN_SWAR
+  #define SCAN_KERNEL_NAME "swar"
+#else
+  #define SCAN_KERNEL_NAME "scalar"
+#endif
+#endif // XML_SCAN_DISPATCH
+
+#endif // XML_SCAN_H
@@ -0,0 +1,586 @@
+/**
+ * \file
+ * \brief   Bulk XML validator. Validates XML files against the generated schema
+ *          keeping multiple file reads in flight.
+
+ * \author  Nandkishor Biradar
+ * \date    16 October 2026
+
+ *  Copyright (c) 2019-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+/*
+ *  ------------------------------ INCLUDE FILES ------------------------------
+ */
+
+#if INGEST_IO_URING
+  #define _GNU_SOURCE   // struct statx filled by io_uring_prep_statx
+#endif // INGEST_IO_URING
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "parse_xml.h"
+
+/*
+ *  ------------------------------- DEFINITION -------------------------------
+ */
+
+//! Root element of the generated schema to validate XML files against.
+#ifndef INGEST_ROOT
+  #define INGEST_ROOT PurchaseOrder_root
+#endif // INGEST_ROOT
+
+//! Use io_uring (liburing) to open, stat, read and close the files. Otherwise each thread reads the files using pread.
+#ifndef INGEST_IO_URING
+  #define INGEST_IO_URING 0
+#endif // INGEST_IO_URING
+
+#if INGEST_IO_URING
+#include <liburing.h>
+#endif // INGEST_IO_URING
+
+//! Default number of file reads in flight per thread.
+#define DEFAULT_QUEUE_DEPTH   32
+
+/*
+ *  -------------------------------- STRUCTURE --------------------------------
+ */
+
+//! Holds the XML file to validate and its result.
+typedef struct
+{
+  char* Path;                 //!< Path of XML file
+  size_t Size;                //!< Size of XML file
+  xml_parse_result_t Result;  //!< Result of validation
+}ingest_file_t;
+
+#if INGEST_IO_URING
+//! Operation of io_uring in flight for a file.
+typedef enum
+{
+  EN_STAGE_OPEN,        //!< File is being opened
+  EN_STAGE_STAT,        //!< Size of file is being read
+  EN_STAGE_READ,        //!< File is being read
+}ingest_stage_t;
+#endif // INGEST_IO_URING
+
+//! Holds the buffer of a file read in flight.
+typedef struct
+{
+  ingest_file_t* File;  //!< File being read. NULL if slot is free.
+  int Descriptor;       //!< File descriptor. -1 if file is not open.
+  char* Buffer;         //!< Buffer to read the file
+  size_t Capacity;      //!< Capacity of buffer
+#if INGEST_IO_URING
+  ingest_stage_t Stage; //!< Operation in flight
+  struct statx Status;  //!< Status of file filled by io_uring
+#endif // INGEST_IO_URING
+}ingest_slot_t;
+
+/*
+ *  ------------------------------ GLOBAL VARIABLES ------------------------------
+ */
+
+#define ADD_RESULT_CODE(code, description) [code] = #description,
+const char* Result_Text[] = {XML_PARSER_RESULT};
+#undef ADD_RESULT_CODE
+
+extern const xs_element_t INGEST_ROOT;
+
+static ingest_file_t* Files;        //!< List of XML files to validate
+static size_t File_Quantity;        //!< Number of XML files
+static size_t File_Capacity;        //!< Capacity of list of XML files
+static size_t Next_File;            //!< Index of next XML file to validate
+static unsigned Queue_Depth = DEFAULT_QUEUE_DEPTH;
+
+/*
+ *  ------------------------------ FUNCTION BODY ------------------------------
+ */
+
+/** \brief Adds the XML file to the list. If path is a directory then adds all the files in it.
+ * Symbolic links to directories inside a directory are not followed, so that a link loop doesn't recurse forever.
+ *
+ * \param path const char* : Path of XML file or directory.
+ * \param link bool : Follow the symbolic link to directory. True for the path given by the user.
+ *
+ */
+static void add_path(const char* path, bool link)
+{
+  struct stat status;
+  if(lstat(path, &status) != 0)
+  {
+    printf("%s: Failed to open.\n", path);
+    return;
+  }
+
+  if(S_ISLNK(status.st_mode))
+  {
+    if(stat(path, &status) != 0)
+    {
+      printf("%s: Failed to open.\n", path);
+      return;
+    }
+    if(S_ISDIR(status.st_mode) && !link)
+    {
+      printf("%s: Symbolic link to directory skipped.\n", path);
+      return;
+    }
+  }
+
+  if(S_ISDIR(status.st_mode))
+  {
+    DIR* directory = opendir(path);
+    if(directory == NULL)
+    {
+      return;
+    }
+
+    struct dirent* entry;
+    while((entry = readdir(directory)) != NULL)
+    {
+      if((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0))
+      {
+        continue;
+      }
+      char* child = malloc(strlen(path) + strlen(entry->d_name) + 2);
+      if(child == NULL)
+      {
+        printf("%s: Failed to allocate memory.\n", path);
+        break;
+      }
+      sprintf(child, "%s/%s", path, entry->d_name);
+      add_path(child, false);
+      free(child);
+    }
+    closedir(directory);
+    return;
+  }
+
+  if(File_Quantity == File_Capacity)
+  {
+    const size_t capacity = File_Capacity ? (File_Capacity * 2) : 1024;
+    ingest_file_t* const files = realloc(Files, capacity * sizeof(ingest_file_t));
+    if(files == NULL)
+    {
+      printf("%s: Failed to allocate memory.\n", path);
+      return;
+    }
+    Files         = files;
+    File_Capacity = capacity;
+  }
+
+  char* const name = strdup(path);
+  if(name == NULL)
+  {
+    printf("%s: Failed to allocate memory.\n", path);
+    return;
+  }
+  Files[File_Quantity].Path   = name;
+  Files[File_Quantity].Size   = 0;
+  Files[File_Quantity].Result = XML_INCOMPLETE_SOURCE;
+  File_Quantity++;
+}
+
+/** \brief Validates the XML source against the schema without storing its content.
+ *
+ * \param source const char* : XML source
+ * \param size size_t : Size of XML source
+ * \return xml_parse_result_t : Result of validation.
+ *
+ */
+static xml_parse_result_t validate(const char* source, size_t size)
+{
+  xml_reader_t reader;
+  xml_event_t event;
+  xml_parse_result_t result;
+
+  xml_reader_init(&reader, &INGEST_ROOT, source, size);
+  do
+  {
+    result = xml_reader_next(&reader, &event);
+  }while((result == XML_PARSE_SUCCESS) && (event.Type != EN_EVENT_NONE));
+
+  return result;
+}
+
+/** \brief Takes the next XML file from the list.
+ *
+ * \return ingest_file_t* : Next XML file. NULL if there is no more file to validate.
+ *
+ */
+static ingest_file_t* take_next_file(void)
+{
+  size_t index = __atomic_fetch_add(&Next_File, 1, __ATOMIC_RELAXED);
+  return (index < File_Quantity) ? &Files[index] : NULL;
+}
+
+/** \brief Grows the buffer of slot to hold its file.
+ *
+ * \param slot ingest_slot_t* const : Slot holding the opened file.
+ * \return bool : false if failed to allocate the buffer. Result of file is then set.
+ *
+ */
+static bool reserve_buffer(ingest_slot_t* const slot)
+{
+  if(slot->Capacity < slot->File->Size)
+  {
+    free(slot->Buffer);
+    slot->Buffer   = malloc(slot->File->Size);
+    slot->Capacity = (slot->Buffer != NULL) ? slot->File->Size : 0;
+    if(slot->Buffer == NULL)
+    {
+      slot->File->Result = FAILED_TO_ALLOCATE_MEMORY;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** \brief Takes the next XML file from the list, opens it and allocates the buffer to read it.
+ *
+ * \param slot ingest_slot_t* const : Slot to hold the opened file.
+ * \return bool : false if there is no more file to validate.
+ *
+ */
+static bool open_next_file(ingest_slot_t* const slot)
+{
+  while((slot->File = take_next_file()) != NULL)
+  {
+    ingest_file_t* const file = slot->File;
+    struct stat status;
+    slot->Descriptor = open(file->Path, O_RDONLY);
+    if((slot->Descriptor < 0) || (fstat(slot->Descriptor, &status) != 0))
+    {
+      if(slot->Descriptor >= 0)
+      {
+        close(slot->Descriptor);
+      }
+      file->Result = XML_FILE_ERROR;
+      continue;
+    }
+
+    file->Size = (size_t)status.st_size;
+    if(!reserve_buffer(slot))
+    {
+      close(slot->Descriptor);
+      continue;
+    }
+    return true;
+  }
+  return false;
+}
+
+/** \brief Reads the remaining part of file synchronously and validates it. File is not closed.
+ *
+ * \param slot ingest_slot_t* const : Slot holding the opened file.
+ * \param length size_t : Length of file already read into the buffer.
+ *
+ */
+static void complete_file(ingest_slot_t* const slot, size_t length)
+{
+  ingest_file_t* const file = slot->File;
+  while(length < file->Size)
+  {
+    ssize_t count = pread(slot->Descriptor, &slot->Buffer[length], file->Size - length, (off_t)length);
+    if(count <= 0)
+    {
+      break;
+    }
+    length += (size_t)count;
+  }
+
+  file->Result = (length == file->Size) ? validate(slot->Buffer, file->Size) : XML_FILE_ERROR;
+}
+
+#if INGEST_IO_URING
+/** \brief Queues the open of next XML file from the list on the slot.
+ *
+ * \param ring struct io_uring* : io_uring of the thread.
+ * \param slot ingest_slot_t* const : Free slot.
+ * \return unsigned : 1 if open is queued, 0 if there is no more file to validate.
+ *
+ */
+static unsigned queue_open(struct io_uring* ring, ingest_slot_t* const slot)
+{
+  slot->Descriptor = -1;
+  slot->File = take_next_file();
+  if(slot->File == NULL)
+  {
+    return 0;
+  }
+
+  struct io_uring_sqe* const sqe = io_uring_get_sqe(ring);
+  io_uring_prep_openat(sqe, AT_FDCWD, slot->File->Path, O_RDONLY, 0);
+  io_uring_sqe_set_data(sqe, slot);
+  slot->Stage = EN_STAGE_OPEN;
+  return 1;
+}
+
+/** \brief Completes the operation of io_uring of the slot and queues its next operation.
+ *  When the file is complete, it queues the close of file and the open of next file on the slot.
+ *
+ * \param ring struct io_uring* : io_uring of the thread.
+ * \param slot ingest_slot_t* const : Slot of the completed operation.
+ * \param result int : Result of the completed operation.
+ * \return unsigned : Number of operations queued.
+ *
+ */
+static unsigned advance_slot(struct io_uring* ring, ingest_slot_t* const slot, int result)
+{
+  ingest_file_t* const file = slot->File;
+  struct io_uring_sqe* sqe;
+  switch(slot->Stage)
+  {
+  case EN_STAGE_OPEN:
+    if(result < 0)
+    {
+      file->Result = XML_FILE_ERROR;
+      break;
+    }
+    slot->Descriptor = result;
+    sqe = io_uring_get_sqe(ring);
+    io_uring_prep_statx(sqe, slot->Descriptor, "", AT_EMPTY_PATH, STATX_SIZE, &slot->Status);
+    io_uring_sqe_set_data(sqe, slot);
+    slot->Stage = EN_STAGE_STAT;
+    return 1;
+
+  case EN_STAGE_STAT:
+    if(result < 0)
+    {
+      file->Result = XML_FILE_ERROR;
+      break;
+    }
+    file->Size = (size_t)slot->Status.stx_size;
+    if(!reserve_buffer(slot))
+    {
+      break;
+    }
+    sqe = io_uring_get_sqe(ring);
+    io_uring_prep_read(sqe, slot->Descriptor, slot->Buffer, file->Size, 0);
+    io_uring_sqe_set_data(sqe, slot);
+    slot->Stage = EN_STAGE_READ;
+    return 1;
+
+  default:    // EN_STAGE_READ
+    if(result < 0)
+    {
+      file->Result = XML_FILE_ERROR;
+    }
+    else
+    {
+      complete_file(slot, (size_t)result);
+    }
+    break;
+  }
+
+  unsigned queued = 0;
+  if(slot->Descriptor >= 0)
+  {
+    // Completion of close doesn't refer to the slot, so the slot is reused at once.
+    sqe = io_uring_get_sqe(ring);
+    io_uring_prep_close(sqe, slot->Descriptor);
+    io_uring_sqe_set_data(sqe, NULL);
+    queued++;
+  }
+  return queued + queue_open(ring, slot);
+}
+
+/** \brief Validates the XML files keeping Queue_Depth files in flight using io_uring.
+ *  Open, stat, read and close of each file are all queued to io_uring.
+ *
+ * \return bool : false if failed to setup or wait on io_uring. Remaining files are then validated using pread.
+ *
+ */
+static bool ingest_io_uring(void)
+{
+  struct io_uring ring;
+  // Each slot queues up to two operations at once: close of its file and open of next file.
+  if(io_uring_queue_init(2 * Queue_Depth, &ring, 0) != 0)
+  {
+    return false;
+  }
+
+  ingest_slot_t* const slots = calloc(Queue_Depth, sizeof(ingest_slot_t));
+  if(slots == NULL)
+  {
+    io_uring_queue_exit(&ring);
+    return false;
+  }
+  unsigned pending = 0;
+  for(unsigned i = 0; i < Queue_Depth; i++)
+  {
+    pending += queue_open(&ring, &slots[i]);
+  }
+  io_uring_submit(&ring);
+
+  while(pending > 0)
+  {
+    struct io_uring_cqe* cqe;
+    int status = io_uring_wait_cqe(&ring, &cqe);
+    if(status == -EINTR)
+    {
+      continue;
+    }
+    if(status != 0)
+    {
+      break;
+    }
+    ingest_slot_t* const slot = io_uring_cqe_get_data(cqe);
+    int result = cqe->res;
+    io_uring_cqe_seen(&ring, cqe);
+    pending--;
+
+    if(slot != NULL)
+    {
+      pending += advance_slot(&ring, slot, result);
+      io_uring_submit(&ring);
+    }
+  }
+
+  // If waiting failed, files in flight are closed and reported as failed.
+  for(unsigned i = 0; (pending > 0) && (i < Queue_Depth); i++)
+  {
+    if(slots[i].File != NULL)
+    {
+      if(slots[i].Descriptor >= 0)
+      {
+        close(slots[i].Descriptor);
+      }
+      slots[i].File->Result = XML_FILE_ERROR;
+    }
+  }
+
+  io_uring_queue_exit(&ring);
+  for(unsigned i = 0; i < Queue_Depth; i++)
+  {
+    free(slots[i].Buffer);
+  }
+  free(slots);
+  return pending == 0;
+}
+#endif // INGEST_IO_URING
+
+/** \brief Worker thread to validate the XML files.
+ *
+ * \param argument void* : unused
+ * \return void* : unused
+ *
+ */
+static void* ingest(void* argument)
+{
+  (void)argument;
+
+#if INGEST_IO_URING
+  if(ingest_io_uring())
+  {
+    return NULL;
+  }
+#endif // INGEST_IO_URING
+
+  ingest_slot_t slot = {0};
+  while(open_next_file(&slot))
+  {
+    complete_file(&slot, 0);
+    close(slot.Descriptor);
+  }
+  free(slot.Buffer);
+  return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+  long threads = sysconf(_SC_NPROCESSORS_ONLN);
+  int option;
+
+  while((option = getopt(argc, argv, "j:q:")) != -1)
+  {
+    switch(option)
+    {
+    case 'j':
+      threads = atol(optarg);
+      break;
+
+    case 'q':
+      Queue_Depth = (unsigned)atol(optarg);
+      break;
+
+    default:
+      printf("Usage: %s [-j threads] [-q queue depth] <XML file or directory>...\n", argv[0]);
+      return 1;
+    }
+  }
+
+  if((optind == argc) || (threads < 1) || (Queue_Depth < 1))
+  {
+    printf("Usage: %s [-j threads] [-q queue depth] <XML file or directory>...\n", argv[0]);
+    return 1;
+  }
+
+  for(int i = optind; i < argc; i++)
+  {
+    add_path(argv[i], true);
+  }
+
+  struct timespec start, stop;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  pthread_t* const worker = malloc((size_t)threads * sizeof(pthread_t));
+  if(worker == NULL)
+  {
+    // Validate the files in the main thread.
+    ingest(NULL);
+  }
+  else
+  {
+    long created = 0;
+    while((created < threads) && (pthread_create(&worker[created], NULL, ingest, NULL) == 0))
+    {
+      created++;
+    }
+    if(created == 0)
+    {
+      ingest(NULL);
+    }
+    for(long i = 0; i < created; i++)
+    {
+      pthread_join(worker[i], NULL);
+    }
+    free(worker);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  double elapsed = (double)(stop.tv_sec - start.tv_sec) + ((double)(stop.tv_nsec - start.tv_nsec) / 1e9);
+
+  size_t failed = 0;
+  size_t bytes = 0;
+  for(size_t i = 0; i < File_Quantity; i++)
+  {
+    printf("%s: %s\n", Files[i].Path, Result_Text[Files[i].Result]);
+    failed += (Files[i].Result != XML_PARSE_SUCCESS);
+    bytes  += Files[i].Size;
+    free(Files[i].Path);
+  }
+  free(Files);
+
+  printf("%zu files, %zu failed, %zu bytes in %.3f s: %.0f files/s, %.1f MB/s (%s)\n",
+         File_Quantity, failed, bytes, elapsed,
+         elapsed > 0 ? File_Quantity / elapsed : 0.0, elapsed > 0 ? bytes / elapsed / 1e6 : 0.0,
+         INGEST_IO_URING ? "io_uring" : "pread");
+
+  return failed ? 2 : 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file
+ * \brief   Callbacks referred by the generated schema of PurchaseOrder.
+ *          Bulk XML validator uses the XML reader, which never calls them.
+
+ * \author  Nandkishor Biradar
+ * \date    16 October 2026
+
+ *  Copyright (c) 2019-2026 Nandkishor Biradar
+ *  https://github.com/kiishor
+
+ *  Distributed under the MIT License, (See accompanying
+ *  file LICENSE or copy at https://mit-license.org/)
+ */
+
+#include <stdint.h>
+
+void shipToCallback(uint32_t occurrence, void* const content, void* context)
+{
+  (void)occurrence;
+  (void)content;
+  (void)context;
+}